@@ -0,0 +1,139 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Minimal microbenchmark harness
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "bench/bench_harness.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+
+std::atomic<uint64_t> allocations_count{0};
+
+void* CountedAllocate(size_t size) {
+  allocations_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* data = std::malloc(size == 0 ? 1 : size)) return data;
+  throw std::bad_alloc();
+}
+
+void* CountedAllocate(size_t size, std::align_val_t alignment) {
+  allocations_count.fetch_add(1, std::memory_order_relaxed);
+  const auto align = static_cast<size_t>(alignment);
+#ifdef _WIN32
+  if (void* data = _aligned_malloc(size == 0 ? 1 : size, align)) return data;
+#else
+  if (void* data = std::aligned_alloc(align, (size + align) / align * align))
+    return data;
+#endif
+  throw std::bad_alloc();
+}
+
+void AlignedFree(void* data) {
+#ifdef _WIN32
+  _aligned_free(data);
+#else
+  std::free(data);
+#endif
+}
+
+}  // namespace
+
+void* operator new(size_t size) { return CountedAllocate(size); }
+
+void* operator new[](size_t size) { return CountedAllocate(size); }
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  return CountedAllocate(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return CountedAllocate(size, alignment);
+}
+
+void operator delete(void* data) noexcept { std::free(data); }
+
+void operator delete[](void* data) noexcept { std::free(data); }
+
+void operator delete(void* data, size_t) noexcept { std::free(data); }
+
+void operator delete[](void* data, size_t) noexcept { std::free(data); }
+
+void operator delete(void* data, std::align_val_t) noexcept {
+  AlignedFree(data);
+}
+
+void operator delete[](void* data, std::align_val_t) noexcept {
+  AlignedFree(data);
+}
+
+void operator delete(void* data, size_t, std::align_val_t) noexcept {
+  AlignedFree(data);
+}
+
+void operator delete[](void* data, size_t, std::align_val_t) noexcept {
+  AlignedFree(data);
+}
+
+namespace cybercafe_monitoring_system_bench {
+
+uint64_t GetAllocationsCount() {
+  return allocations_count.load(std::memory_order_relaxed);
+}
+
+void BenchRunner::Add(std::string name, std::vector<BenchParams> params_list,
+                      Body body) {
+  benchmarks_.push_back({std::move(name), std::move(params_list),
+                         std::move(body)});
+}
+
+// Runs the benchmarks whose name contains the filter
+int BenchRunner::Run(std::string_view filter,
+                     std::chrono::nanoseconds min_time) const {
+  std::printf("%-32s %8s %8s %8s %12s %14s\n", "benchmark", "tables",
+              "clients", "queue", "ns/event", "allocs/event");
+
+  int runs = 0;
+  for (const auto& benchmark : benchmarks_) {
+    if (benchmark.name.find(filter) == std::string::npos) continue;
+
+    for (const auto& params : benchmark.params_list) {
+      Meter meter;
+      do {
+        benchmark.body(params, meter);
+      } while (meter.GetElapsed() < min_time);
+
+      const auto events =
+          static_cast<double>(std::max<uint64_t>(meter.GetEvents(), 1));
+      std::printf("%-32s %8d %8d %8d %12.1f %14.3f\n", benchmark.name.c_str(),
+                  params.tables, params.clients, params.queue,
+                  static_cast<double>(meter.GetElapsed().count()) / events,
+                  static_cast<double>(meter.GetAllocations()) / events);
+      std::fflush(stdout);
+    }
+    ++runs;
+  }
+
+  return runs;
+}
+
+}  // namespace cybercafe_monitoring_system_bench
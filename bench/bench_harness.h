@@ -0,0 +1,104 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Minimal microbenchmark harness
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef BENCH_BENCH_HARNESS_H_
+#define BENCH_BENCH_HARNESS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cybercafe_monitoring_system_bench {
+
+// Number of operator new calls since the program start. Counted by the
+// replacement operator new of the benchmark executable
+uint64_t GetAllocationsCount();
+
+// Keeps the compiler from dropping the computation of the value
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) or defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+struct BenchParams {
+  int tables = 0;
+
+  int clients = 0;
+
+  int queue = 0;
+};
+
+// Accumulates the measured parts of one benchmark. Setup done outside Measure
+// is not counted
+class Meter final {
+ public:
+  // Times the call and counts its allocations as made for the given number of
+  // events
+  template <typename Function>
+  void Measure(uint64_t events, Function&& function) {
+    const uint64_t allocations_before = GetAllocationsCount();
+    const auto start = std::chrono::steady_clock::now();
+
+    function();
+
+    elapsed_ += std::chrono::steady_clock::now() - start;
+    allocations_ += GetAllocationsCount() - allocations_before;
+    events_ += events;
+  }
+
+  inline std::chrono::nanoseconds GetElapsed() const { return elapsed_; }
+
+  inline uint64_t GetAllocations() const { return allocations_; }
+
+  inline uint64_t GetEvents() const { return events_; }
+
+ private:
+  std::chrono::nanoseconds elapsed_{0};
+
+  uint64_t allocations_ = 0;
+
+  uint64_t events_ = 0;
+};
+
+// Runs every registered benchmark with every parameter set until the measured
+// time reaches the minimum and prints ns/event and allocations/event
+class BenchRunner final {
+ public:
+  using Body = std::function<void(const BenchParams&, Meter&)>;
+
+  void Add(std::string name, std::vector<BenchParams> params_list, Body body);
+
+  // Runs the benchmarks whose name contains the filter. Returns the number of
+  // benchmarks run
+  int Run(std::string_view filter, std::chrono::nanoseconds min_time) const;
+
+ private:
+  struct Benchmark {
+    std::string name;
+
+    std::vector<BenchParams> params_list;
+
+    Body body;
+  };
+
+  std::vector<Benchmark> benchmarks_;
+};
+
+}  // namespace cybercafe_monitoring_system_bench
+
+#endif  // BENCH_BENCH_HARNESS_H_
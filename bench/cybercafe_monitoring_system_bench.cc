@@ -0,0 +1,315 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Microbenchmarks of the event handlers and state structures
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <numeric>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench/bench_harness.h"
+#include "include/client_name_interner.h"
+#include "include/client_name_sorter.h"
+#include "include/client_name_validator.h"
+#include "include/cybercafe_monitoring_system.h"
+#include "include/event_line_parser.h"
+#include "include/output_sink.h"
+#include "include/read_input_data.h"
+#include "include/session_ledger.h"
+
+namespace {
+
+using cybercafe_monitoring_system::ClientId;
+using cybercafe_monitoring_system::ClientNameInterner;
+using cybercafe_monitoring_system::ClientNameSorter;
+using cybercafe_monitoring_system::CybercafeMonitoringSystem;
+using cybercafe_monitoring_system::NullOutputSink;
+using cybercafe_monitoring_system::RevenueReport;
+using cybercafe_monitoring_system::SessionLedger;
+using cybercafe_monitoring_system::TariffPlan;
+using cybercafe_monitoring_system::TimePoint;
+using cybercafe_monitoring_system_bench::BenchParams;
+using cybercafe_monitoring_system_bench::BenchRunner;
+using cybercafe_monitoring_system_bench::Meter;
+using std::chrono::minutes;
+
+using ClientArrivedEvent = CybercafeMonitoringSystem::ClientArrivedEvent;
+using ClientSatAtTableEvent = CybercafeMonitoringSystem::ClientSatAtTableEvent;
+using ClientWaitingEvent = CybercafeMonitoringSystem::ClientWaitingEvent;
+using ClientLeftEvent = CybercafeMonitoringSystem::ClientLeftEvent;
+using EventType = CybercafeMonitoringSystem::Event::Type;
+
+// Open the whole day, so no event is rejected as NotOpenYet
+const TimePoint kOpeningTime{minutes{0}};
+const TimePoint kClosingTime{minutes{23 * 60 + 59}};
+const TimePoint kEventTime{minutes{12 * 60}};
+constexpr int kHourlyRate = 10;
+
+std::vector<std::string> MakeClientNames(int count) {
+  std::vector<std::string> names;
+  names.reserve(static_cast<size_t>(count));
+  for (int i = 0; i != count; ++i) names.push_back(std::format("client{}", i));
+  return names;
+}
+
+// System with every given client inside, the first tables_count of them at
+// the tables
+class Day final {
+ public:
+  Day(int tables_count, const std::vector<std::string>& clients, int seated)
+      : system_(kOpeningTime, kClosingTime, tables_count, kHourlyRate,
+                output_) {
+    system_.StartWorkDayTrigger();
+    for (const auto& client : clients)
+      ClientArrivedEvent(kEventTime, client).Handle(system_);
+    for (int i = 0; i != seated; ++i)
+      ClientSatAtTableEvent(kEventTime, clients[static_cast<size_t>(i)], i + 1,
+                            EventType::kIncoming)
+          .Handle(system_);
+  }
+
+  inline CybercafeMonitoringSystem& System() { return system_; }
+
+ private:
+  NullOutputSink output_;
+
+  CybercafeMonitoringSystem system_;
+};
+
+void BenchClientArrived(const BenchParams& params, Meter& meter) {
+  const auto clients = MakeClientNames(params.clients);
+  Day day(params.tables, {}, 0);
+
+  meter.Measure(clients.size(), [&] {
+    for (const auto& client : clients)
+      ClientArrivedEvent(kEventTime, client).Handle(day.System());
+  });
+}
+
+void BenchClientSatAtTable(const BenchParams& params, Meter& meter) {
+  const auto clients = MakeClientNames(params.clients);
+  Day day(params.tables, clients, 0);
+
+  // Once every table is taken the rest hit the PlaceIsBusy path
+  meter.Measure(clients.size(), [&] {
+    for (int i = 0; i != params.clients; ++i)
+      ClientSatAtTableEvent(kEventTime, clients[static_cast<size_t>(i)],
+                            i % params.tables + 1, EventType::kIncoming)
+          .Handle(day.System());
+  });
+}
+
+void BenchWaitingQueue(const BenchParams& params, Meter& meter) {
+  const auto clients = MakeClientNames(params.tables + params.queue);
+  Day day(params.tables, clients, params.tables);
+  const auto waiting = std::span(clients).subspan(
+      static_cast<size_t>(params.tables));
+
+  // Every client joins the queue, every second one leaves it from the middle,
+  // then the seated clients leave and the rest of the queue takes their places
+  meter.Measure(waiting.size() + waiting.size() / 2 +
+                    static_cast<size_t>(params.tables),
+                [&] {
+                  for (const auto& client : waiting)
+                    ClientWaitingEvent(kEventTime, client).Handle(day.System());
+                  for (size_t i = 1; i < waiting.size(); i += 2)
+                    ClientLeftEvent(kEventTime, waiting[i],
+                                    EventType::kIncoming)
+                        .Handle(day.System());
+                  for (int i = 0; i != params.tables; ++i)
+                    ClientLeftEvent(kEventTime,
+                                    clients[static_cast<size_t>(i)],
+                                    EventType::kIncoming)
+                        .Handle(day.System());
+                });
+}
+
+void BenchClientDeparture(const BenchParams& params, Meter& meter) {
+  const auto clients = MakeClientNames(params.clients);
+  Day day(params.tables, clients, std::min(params.tables, params.clients));
+
+  meter.Measure(clients.size(), [&] {
+    for (const auto& client : clients)
+      ClientLeftEvent(kEventTime, client, EventType::kIncoming)
+          .Handle(day.System());
+  });
+}
+
+void BenchCybercafeClose(const BenchParams& params, Meter& meter) {
+  const auto clients = MakeClientNames(params.clients);
+  Day day(params.tables, clients, std::min(params.tables, params.clients));
+
+  meter.Measure(clients.size(), [&] { day.System().EndWorkDayTrigger(); });
+}
+
+void BenchParseTime(const BenchParams&, Meter& meter) {
+  std::vector<std::string> tokens;
+  for (int minute = 0; minute != 24 * 60; ++minute)
+    tokens.push_back(std::format("{:02}:{:02}", minute / 60, minute % 60));
+
+  int64_t checksum = 0;
+  meter.Measure(tokens.size(), [&] {
+    for (const auto& token : tokens)
+      checksum += cybercafe_monitoring_system::ParseTime(token)
+                      .time_since_epoch()
+                      .count();
+  });
+  cybercafe_monitoring_system_bench::DoNotOptimize(checksum);
+}
+
+// "HH:MM <id> <client> [table]" lines of arrivals and seatings
+std::vector<std::string> MakeEventLines(const BenchParams& params) {
+  std::vector<std::string> lines;
+  for (int i = 0; i != params.clients; ++i) {
+    lines.push_back(std::format("12:00 1 client{}", i));
+    lines.push_back(
+        std::format("12:00 2 client{} {}", i, i % params.tables + 1));
+  }
+  return lines;
+}
+
+void BenchParseEventLine(const BenchParams& params, Meter& meter) {
+  const auto lines = MakeEventLines(params);
+
+  int checksum = 0;
+  meter.Measure(lines.size(), [&] {
+    for (const auto& line : lines)
+      checksum += cybercafe_monitoring_system::ParseEventLine(line).table_id;
+  });
+  cybercafe_monitoring_system_bench::DoNotOptimize(checksum);
+}
+
+// The whole istream path: getline, ParseEventLine and the handlers
+void BenchProcessingInputData(const BenchParams& params, Meter& meter) {
+  const auto lines = MakeEventLines(params);
+  std::string text = std::format("{}\n00:00 23:59\n{}\n", params.tables,
+                                 kHourlyRate);
+  for (const auto& line : lines) (text += line) += '\n';
+
+  NullOutputSink output;
+  std::istringstream input(text);
+
+  meter.Measure(lines.size(), [&] {
+    cybercafe_monitoring_system_test::ProcessingInputData(input, output);
+  });
+}
+
+void BenchClientsNameCompare(const BenchParams& params, Meter& meter) {
+  auto names = MakeClientNames(params.clients);
+  std::ranges::shuffle(names, std::mt19937{42});
+  std::vector<std::string_view> views(names.begin(), names.end());
+
+  meter.Measure(views.size(), [&] {
+    std::ranges::sort(views, CybercafeMonitoringSystem::ClientsNameCompare{});
+  });
+}
+
+// Names of the given size made of the whole alphabet
+void BenchIsClientNameValid(const BenchParams& params, Meter& meter) {
+  constexpr std::string_view kAlphabet =
+      "abcdefghijklmnopqrstuvwxyz0123456789_-";
+  std::vector<std::string> names(1024);
+  for (size_t i = 0; i != names.size(); ++i)
+    for (int j = 0; j != params.clients; ++j)
+      names[i] += kAlphabet[(i + j) % kAlphabet.size()];
+
+  meter.Measure(names.size(), [&] {
+    size_t valid = 0;
+    for (const auto& name : names)
+      valid += cybercafe_monitoring_system::IsClientNameValid(name);
+    cybercafe_monitoring_system_bench::DoNotOptimize(valid);
+  });
+}
+
+// The k11 order of the end of the day
+void BenchClientNameSorter(const BenchParams& params, Meter& meter) {
+  auto names = MakeClientNames(params.clients);
+  std::ranges::shuffle(names, std::mt19937{42});
+
+  ClientNameInterner interner;
+  for (const auto& name : names) interner.Intern(name);
+
+  std::vector<ClientId> clients(names.size());
+  ClientNameSorter sorter;
+
+  meter.Measure(clients.size(), [&] {
+    std::iota(clients.begin(), clients.end(), ClientId{0});
+    sorter.Sort(clients, interner);
+  });
+}
+
+// params.clients sessions of random length at params.tables tables, priced
+// under an hourly, a per-minute and a capped plan
+void BenchRepriceSessions(const BenchParams& params, Meter& meter) {
+  const auto clients = MakeClientNames(params.clients);
+  std::mt19937 random(22);
+  std::uniform_int_distribution<int32_t> table(1, params.tables);
+  std::uniform_int_distribution<int32_t> minute(0, 24 * 60 - 1);
+
+  SessionLedger ledger;
+  for (ClientId client = 0; client != clients.size(); ++client) {
+    const int32_t start = minute(random);
+    ledger.Append(client, clients[client], table(random), start,
+                  std::min(start + minute(random) / 4, 24 * 60), 0);
+  }
+
+  const std::vector<TariffPlan> plans = {
+      {kHourlyRate, 60, 0}, {1, 1, 0}, {kHourlyRate, 60, 3 * kHourlyRate}};
+  std::vector<RevenueReport> reports(plans.size(),
+                                     RevenueReport(params.tables));
+  meter.Measure(clients.size() * plans.size(), [&] {
+    RepriceSessions(ledger, plans, reports);
+    cybercafe_monitoring_system_bench::DoNotOptimize(reports[0].total);
+  });
+}
+
+}  // namespace
+
+// Usage: cybercafe_monitoring_system_bench [name filter] [min time in ms]
+int main(int argc, char* argv[]) {
+  const std::string_view filter = argc > 1 ? argv[1] : "";
+  const auto min_time =
+      std::chrono::milliseconds{argc > 2 ? std::stoi(argv[2]) : 200};
+
+  const std::vector<BenchParams> small_and_large = {
+      {16, 1024, 0}, {1024, 1024, 0}, {1024, 65536, 0}, {65536, 65536, 0}};
+
+  BenchRunner runner;
+  runner.Add("ClientArrivedEvent::Handle", {{16, 1024, 0}, {16, 65536, 0}},
+             BenchClientArrived);
+  runner.Add("ClientSatAtTableEvent::Handle", small_and_large,
+             BenchClientSatAtTable);
+  runner.Add("ClientWaiting/ClientLeftEvent",
+             {{16, 0, 16}, {1024, 0, 16}, {1024, 0, 1024}, {65536, 0, 65536}},
+             BenchWaitingQueue);
+  runner.Add("ProcessClientDeparture", small_and_large, BenchClientDeparture);
+  runner.Add("CybercafeClose", small_and_large, BenchCybercafeClose);
+  runner.Add("ParseTime", {{0, 0, 0}}, BenchParseTime);
+  runner.Add("ParseEventLine", {{16, 1024, 0}, {1024, 65536, 0}},
+             BenchParseEventLine);
+  runner.Add("ProcessingInputData", {{16, 1024, 0}, {1024, 65536, 0}},
+             BenchProcessingInputData);
+  runner.Add("ClientsNameCompare", {{0, 1024, 0}, {0, 65536, 0}},
+             BenchClientsNameCompare);
+  runner.Add("IsClientNameValid", {{0, 8, 0}, {0, 24, 0}, {0, 64, 0}},
+             BenchIsClientNameValid);
+  runner.Add("ClientNameSorter", {{0, 1024, 0}, {0, 65536, 0}},
+             BenchClientNameSorter);
+  runner.Add("RepriceSessions", {{16, 65536, 0}, {1024, 1048576, 0}},
+             BenchRepriceSessions);
+
+  return runner.Run(filter, min_time) > 0 ? 0 : 1;
+}
@@ -0,0 +1,314 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// End-to-end throughput regression harness
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "include/day_log_generator.h"
+#include "include/output_sink.h"
+#include "include/read_input_data.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+using cybercafe_monitoring_system_test::InputMode;
+using cybercafe_monitoring_system_test::ProcessingStats;
+
+constexpr std::string_view kUsage =
+    "Usage: cybercafe_monitoring_system_perf --name <run name> --events <n>\n"
+    "  [--mode buffered|stream|mmap|pipelined|parallel|binary] [--tables <n>]\n"
+    "  [--seed <n>] [--work-dir <dir>] [--results <json>]\n"
+    "  [--baseline <json>] [--margin <fraction>]\n"
+    "Generates a day log, runs it through ProcessingInputData and writes the\n"
+    "results. With --baseline the run fails if it is slower or uses more\n"
+    "memory than the baseline by more than the margin (0.25). A missing\n"
+    "baseline is created from the run\n";
+
+struct HarnessOptions {
+  std::string name = "perf";
+
+  uint64_t events_count = 10000;
+
+  int tables_count = 100;
+
+  uint64_t seed = 1;
+
+  std::string mode = "buffered";
+
+  std::filesystem::path work_dir = std::filesystem::temp_directory_path();
+
+  std::filesystem::path results_path;
+
+  std::filesystem::path baseline_path;
+
+  double margin = 0.25;
+};
+
+struct RunResults {
+  std::string name;
+
+  std::string mode;
+
+  double generate_seconds = 0;
+
+  ProcessingStats stats;
+
+  double total_seconds = 0;
+
+  double events_per_second = 0;
+
+  uint64_t peak_rss_kb = 0;
+};
+
+// Peak resident set size of the process so far
+uint64_t PeakRssKb() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return counters.PeakWorkingSetSize / 1024;
+  return 0;
+#else
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+inline double Seconds(std::chrono::nanoseconds duration) {
+  return std::chrono::duration<double>(duration).count();
+}
+
+HarnessOptions ParseOptions(int argc, char* argv[]) {
+  HarnessOptions options;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view option = argv[i];
+    auto value = [&]() -> std::string {
+      if (++i >= argc)
+        throw std::invalid_argument(std::string(option) + " needs a value");
+      return argv[i];
+    };
+
+    if (option == "--name")
+      options.name = value();
+    else if (option == "--events")
+      options.events_count = std::stoull(value());
+    else if (option == "--tables")
+      options.tables_count = std::stoi(value());
+    else if (option == "--seed")
+      options.seed = std::stoull(value());
+    else if (option == "--mode")
+      options.mode = value();
+    else if (option == "--work-dir")
+      options.work_dir = value();
+    else if (option == "--results")
+      options.results_path = value();
+    else if (option == "--baseline")
+      options.baseline_path = value();
+    else if (option == "--margin")
+      options.margin = std::stod(value());
+    else
+      throw std::invalid_argument("Unknown option: " + std::string(option));
+  }
+
+  if (options.mode != "buffered" and options.mode != "stream" and
+      options.mode != "mmap" and options.mode != "pipelined" and
+      options.mode != "parallel" and options.mode != "binary")
+    throw std::invalid_argument("Unknown mode: " + options.mode);
+
+  return options;
+}
+
+RunResults Run(const HarnessOptions& options) {
+  RunResults results;
+  results.name = options.name;
+  results.mode = options.mode;
+
+  std::filesystem::create_directories(options.work_dir);
+  const std::filesystem::path log_path =
+      options.work_dir / std::format("{}.log", options.name);
+
+  const auto generate_start = std::chrono::steady_clock::now();
+  {
+    cybercafe_monitoring_system::DayLogOptions log_options{
+        .seed = options.seed,
+        .tables_count = options.tables_count,
+        .events_count = options.events_count,
+        .arrivals = cybercafe_monitoring_system::ArrivalDistribution::kRushHour};
+    cybercafe_monitoring_system::FileOutputSink log(log_path);
+    cybercafe_monitoring_system::GenerateDayLog(log_options, log);
+    log.Close();
+  }
+  results.generate_seconds =
+      Seconds(std::chrono::steady_clock::now() - generate_start);
+
+  // The output is formatted but dropped, so the disk does not skew the run
+  cybercafe_monitoring_system::NullOutputSink output;
+  if (options.mode == "mmap") {
+    cybercafe_monitoring_system_test::ProcessingMappedInputData(
+        log_path, output, &results.stats);
+  } else if (options.mode == "pipelined") {
+    cybercafe_monitoring_system_test::ProcessingPipelinedInputData(
+        log_path, output, &results.stats);
+  } else if (options.mode == "parallel") {
+    cybercafe_monitoring_system_test::ProcessingParallelInputData(
+        log_path, output, 0, &results.stats);
+  } else if (options.mode == "binary") {
+    // The conversion is done once per log, so it is not timed
+    std::filesystem::path binary_path = log_path;
+    binary_path += ".bin";
+    cybercafe_monitoring_system_test::ConvertTextToBinaryLog(log_path,
+                                                             binary_path);
+    cybercafe_monitoring_system_test::ProcessingBinaryInputData(
+        binary_path, output, &results.stats);
+    std::filesystem::remove(binary_path);
+  } else {
+    std::ifstream file(log_path);
+    cybercafe_monitoring_system_test::ProcessingInputData(
+        file, output,
+        options.mode == "stream" ? InputMode::kStreaming : InputMode::kBuffered,
+        &results.stats);
+  }
+
+  std::filesystem::remove(log_path);
+
+  const ProcessingStats& stats = results.stats;
+  results.total_seconds = Seconds(stats.read + stats.open + stats.handle +
+                                  stats.close);
+  results.events_per_second =
+      results.total_seconds > 0
+          ? static_cast<double>(stats.events) / results.total_seconds
+          : 0;
+  results.peak_rss_kb = PeakRssKb();
+
+  return results;
+}
+
+std::string ToJson(const RunResults& results) {
+  const ProcessingStats& stats = results.stats;
+  return std::format(
+      "{{\n"
+      "  \"name\": \"{}\",\n"
+      "  \"mode\": \"{}\",\n"
+      "  \"events\": {},\n"
+      "  \"generate_seconds\": {:.6f},\n"
+      "  \"read_seconds\": {:.6f},\n"
+      "  \"open_seconds\": {:.6f},\n"
+      "  \"handle_seconds\": {:.6f},\n"
+      "  \"close_seconds\": {:.6f},\n"
+      "  \"total_seconds\": {:.6f},\n"
+      "  \"events_per_second\": {:.1f},\n"
+      "  \"peak_rss_kb\": {}\n"
+      "}}\n",
+      results.name, results.mode, stats.events, results.generate_seconds,
+      Seconds(stats.read), Seconds(stats.open), Seconds(stats.handle),
+      Seconds(stats.close), results.total_seconds, results.events_per_second,
+      results.peak_rss_kb);
+}
+
+// Reads a number field of a results file written by ToJson
+std::optional<double> ReadJsonNumber(std::string_view json,
+                                     std::string_view key) {
+  const size_t key_position = json.find(std::format("\"{}\":", key));
+  if (key_position == std::string_view::npos) return std::nullopt;
+
+  const std::string rest(json.substr(key_position + key.size() + 3));
+  char* end = nullptr;
+  const double value = std::strtod(rest.c_str(), &end);
+  if (end == rest.c_str()) return std::nullopt;
+  return value;
+}
+
+void WriteFile(const std::filesystem::path& path, std::string_view text) {
+  if (path.has_parent_path())
+    std::filesystem::create_directories(path.parent_path());
+
+  std::ofstream file(path);
+  file << text;
+  if (!file) throw std::runtime_error("Cannot write " + path.string());
+}
+
+// Returns false if the run is worse than the baseline by more than the margin
+bool CompareWithBaseline(const RunResults& results,
+                         const HarnessOptions& options) {
+  std::ifstream file(options.baseline_path);
+  std::stringstream baseline;
+  baseline << file.rdbuf();
+
+  bool passed = true;
+  auto check = [&](std::string_view key, double value, bool higher_is_better) {
+    const auto expected = ReadJsonNumber(baseline.str(), key);
+    if (not expected) {
+      std::cout << std::format("{}: no baseline\n", key);
+      return;
+    }
+
+    const double limit = higher_is_better ? *expected * (1 - options.margin)
+                                          : *expected * (1 + options.margin);
+    const bool ok = higher_is_better ? value >= limit : value <= limit;
+    std::cout << std::format("{}: {:.3f} baseline {:.3f} limit {:.3f} {}\n",
+                             key, value, *expected, limit,
+                             ok ? "ok" : "REGRESSION");
+    passed = passed and ok;
+  };
+
+  check("events_per_second", results.events_per_second, true);
+  check("total_seconds", results.total_seconds, false);
+  check("peak_rss_kb", static_cast<double>(results.peak_rss_kb), false);
+
+  return passed;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    const HarnessOptions options = ParseOptions(argc, argv);
+    const RunResults results = Run(options);
+    const std::string json = ToJson(results);
+
+    std::cout << json;
+    if (not options.results_path.empty()) WriteFile(options.results_path, json);
+
+    if (options.baseline_path.empty()) return 0;
+
+    if (not std::filesystem::exists(options.baseline_path)) {
+      WriteFile(options.baseline_path, json);
+      std::cout << "Baseline created: " << options.baseline_path.string()
+                << "\n";
+      return 0;
+    }
+
+    return CompareWithBaseline(results, options) ? 0 : 1;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\n" << kUsage;
+    return 1;
+  }
+}
@@ -0,0 +1,83 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Processing many day logs at once
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_BATCH_RUNNER_H_
+#define INCLUDE_BATCH_RUNNER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "include/output_sink.h"
+#include "include/read_input_data.h"
+
+namespace cybercafe_monitoring_system_test {
+
+struct BatchOptions {
+  // Every input gets its own output file here
+  std::filesystem::path output_dir;
+
+  // 0 means one per hardware thread
+  size_t threads_count = 0;
+
+  InputMode mode = InputMode::kBuffered;
+
+  // Regular files are read with ProcessingMappedInputData
+  bool use_mapped_reader = false;
+};
+
+struct BatchFileResult {
+  std::filesystem::path input_path;
+
+  std::filesystem::path output_path;
+
+  uintmax_t input_bytes = 0;
+
+  std::chrono::nanoseconds elapsed{0};
+
+  // Empty if the file was processed without errors
+  std::string error;
+};
+
+struct BatchResult {
+  // In the order of the inputs
+  std::vector<BatchFileResult> files;
+
+  std::chrono::nanoseconds elapsed{0};
+
+  size_t threads_count = 0;
+
+  size_t GetFailedCount() const;
+};
+
+// Expands the arguments into input files. A directory gives its regular files
+// in name order, "@<manifest>" gives the paths listed in the manifest one per
+// line, relative ones are taken from the manifest directory
+std::vector<std::filesystem::path> CollectBatchInputs(
+    std::span<const std::string_view> arguments);
+
+// Runs every input through its own CybercafeMonitoringSystem on a work
+// stealing pool. The output of an input is written to
+// <output_dir>/<input filename>.out, inputs with the same filename get a
+// numeric suffix in input order. A failed input does not stop the others
+BatchResult RunBatch(std::span<const std::filesystem::path> inputs,
+                     const BatchOptions& options);
+
+// Prints the throughput of every input and of the whole run
+void PrintBatchSummary(const BatchResult& result,
+                       cybercafe_monitoring_system::OutputSink& output);
+
+}  // namespace cybercafe_monitoring_system_test
+
+#endif  // INCLUDE_BATCH_RUNNER_H_
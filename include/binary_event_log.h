@@ -0,0 +1,123 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Compact binary form of the event log
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_BINARY_EVENT_LOG_H_
+#define INCLUDE_BINARY_EVENT_LOG_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "include/client_name_interner.h"
+#include "include/cybercafe_monitoring_system.h"
+
+namespace cybercafe_monitoring_system {
+
+inline constexpr uint32_t kBinaryEventLogVersion = 1;
+
+// Configuration of the day, the first three lines of the text format
+struct EventLogHeader {
+  // Minutes since midnight
+  int32_t opening_minutes = 0;
+
+  int32_t closing_minutes = 0;
+
+  int32_t tables_count = 0;
+
+  int32_t hourly_rate = 0;
+};
+
+// Layout: the header, blocks of packed events, the dictionary of client names
+// in the order they are first seen and the offset of the dictionary. Every
+// block and the dictionary carry a checksum. An event is packed into a tag
+// byte with the id and a small time step, a varint client index and, for k2,
+// a varint table id, usually 3 or 4 bytes instead of about 20 of text
+class BinaryEventLogWriter final {
+ public:
+  // Creates the file and writes the header. Throws std::runtime_error if the
+  // file cannot be created
+  BinaryEventLogWriter(const std::filesystem::path& path,
+                       const EventLogHeader& header);
+
+  BinaryEventLogWriter(const BinaryEventLogWriter&) = delete;
+  BinaryEventLogWriter& operator=(const BinaryEventLogWriter&) = delete;
+
+  // A log that was not finished stays incomplete and is rejected on reading
+  ~BinaryEventLogWriter();
+
+  // The id must be an incoming one, the name a valid client name and the
+  // table id, for k2, within the tables count
+  void Append(int32_t minutes, CybercafeMonitoringSystem::Event::Id id,
+              std::string_view client_name, int32_t table_id = 0);
+
+  // Writes the last block, the dictionary and its offset, then closes the
+  // file. Throws std::runtime_error if writing fails
+  void Finish();
+
+ private:
+  static constexpr uint32_t kBlockEvents = 4096;
+
+  void FlushBlock();
+
+  void WriteBytes(std::string_view bytes);
+
+  std::FILE* file_ = nullptr;
+
+  uint64_t offset_ = 0;
+
+  ClientNameInterner client_names_;
+
+  std::string block_;
+
+  uint32_t block_events_ = 0;
+
+  int32_t previous_minutes_ = 0;
+};
+
+// Reads a log in place, e.g. from a MappedFile. Blocks are decoded one at a
+// time straight into the records the system handles
+class BinaryEventLogReader final {
+ public:
+  // Checks the header and the dictionary. Throws std::runtime_error if the
+  // data is not a complete log of this version
+  explicit BinaryEventLogReader(std::string_view data);
+
+  inline const EventLogHeader& GetHeader() const { return header_; }
+
+  inline size_t GetClientsCount() const { return client_names_.size(); }
+
+  // Client names are valid, the index is below GetClientsCount()
+  inline std::string_view GetClientName(uint32_t index) const {
+    return client_names_[index];
+  }
+
+  // Decodes the next block into events, replacing their contents. Dictionary
+  // indices are mapped to clients[index]. Returns false after the last block.
+  // Throws std::runtime_error if the block is damaged or has a table id out of
+  // the tables count
+  bool NextBlock(std::span<const ClientId> clients,
+                 std::vector<CybercafeMonitoringSystem::EventRecord>& events);
+
+ private:
+  EventLogHeader header_;
+
+  std::vector<std::string_view> client_names_;
+
+  // Blocks not decoded yet
+  std::string_view blocks_;
+};
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_BINARY_EVENT_LOG_H_
@@ -0,0 +1,82 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Crash-safe snapshots of the cybercafe monitoring system state
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_CHECKPOINT_H_
+#define INCLUDE_CHECKPOINT_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "include/cybercafe_monitoring_system.h"
+
+namespace cybercafe_monitoring_system {
+
+inline constexpr uint32_t kCheckpointVersion = 3;
+
+// Checksum of no input bytes
+inline constexpr uint64_t kInputChecksumBasis = 0xcbf29ce484222325;
+
+// Where in the input a checkpoint was taken
+struct CheckpointPosition {
+  // Bytes of the input consumed, the tail starts here
+  uint64_t input_offset = 0;
+
+  // Events handled before the checkpoint
+  uint64_t events = 0;
+
+  // Time of the last handled event, for the order check of the tail
+  std::optional<int32_t> last_event_minutes;
+
+  // Fingerprint of the input: its whole size and the checksum of the bytes
+  // before input_offset
+  uint64_t input_size = 0;
+
+  uint64_t input_checksum = kInputChecksumBasis;
+};
+
+// FNV-1a of the bytes, continuing the checksum of the bytes before them
+uint64_t ChecksumInput(std::string_view bytes,
+                       uint64_t checksum = kInputChecksumBasis);
+
+// Binary layout of the state: the configuration, the position, the total
+// revenue, the clients inside with their names in id order, the waiting queue
+// from the front, the statistics of every table and the changes of the
+// occupancy timeline. Integers are stored in the byte order of the machine, a
+// checkpoint is read back where it was written
+class CheckpointCodec final {
+ public:
+  static void Encode(const CybercafeMonitoringSystem& system,
+                     const CheckpointPosition& position, std::string& data);
+
+  // Throws std::runtime_error if the data is damaged, of another version or
+  // of a system with another configuration
+  static CheckpointPosition Decode(std::string_view data,
+                                   CybercafeMonitoringSystem& system);
+};
+
+// Writes the checkpoint into a temporary file next to the path, syncs it to
+// the disk and renames it over the path, so the path always holds a complete
+// checkpoint
+void WriteCheckpoint(const CybercafeMonitoringSystem& system,
+                     const CheckpointPosition& position,
+                     const std::filesystem::path& path);
+
+// Maps the checkpoint and restores its state into a system built with the
+// same configuration. Throws std::runtime_error if the file is not a valid
+// checkpoint of such a system
+CheckpointPosition LoadCheckpoint(const std::filesystem::path& path,
+                                  CybercafeMonitoringSystem& system);
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_CHECKPOINT_H_
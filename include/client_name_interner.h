@@ -0,0 +1,88 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Mapping of client names to dense integer ids
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_CLIENT_NAME_INTERNER_H_
+#define INCLUDE_CLIENT_NAME_INTERNER_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "include/day_arena.h"
+
+namespace cybercafe_monitoring_system {
+
+// Dense client id, valid until the interner is cleared
+using ClientId = uint32_t;
+
+inline constexpr ClientId kNoClient = std::numeric_limits<ClientId>::max();
+
+// Stores every distinct client name once and numbers names from 0 in the order
+// they are first seen. The names and the map nodes come from one arena, so
+// Clear drops them all at once instead of freeing them one by one
+class ClientNameInterner final {
+ public:
+  ClientNameInterner();
+
+  // Returns the id of the name, assigning the next free one to a new name
+  inline ClientId Intern(std::string_view name) {
+    if (auto it = ids_->find(name); it != ids_->end()) return it->second;
+
+    // The key has to point to the stored copy, not to the caller's text
+    const auto id = static_cast<ClientId>(names_.size());
+    ids_->emplace(names_.emplace_back(CopyName(name)), id);
+    return id;
+  }
+
+  // Returns the id of a known name or kNoClient
+  inline ClientId Find(std::string_view name) const {
+    auto it = ids_->find(name);
+    return it == ids_->end() ? kNoClient : it->second;
+  }
+
+  inline std::string_view GetName(ClientId id) const { return names_[id]; }
+
+  inline size_t Size() const { return names_.size(); }
+
+  // Forgets every name in O(1) by resetting the arena. The map is made again
+  // with room for as many names as there were
+  void Clear();
+
+ private:
+  using IdMap = std::pmr::unordered_map<std::string_view, ClientId>;
+
+  inline std::string_view CopyName(std::string_view name) {
+    char* copy = static_cast<char*>(arena_->allocate(name.size(), 1));
+    std::ranges::copy(name, copy);
+    return {copy, name.size()};
+  }
+
+  // Makes an empty map in the arena
+  IdMap* MakeIdMap(size_t names_count);
+
+  // Behind a pointer, so the map keeps its resource when the interner moves
+  std::unique_ptr<DayArena> arena_;
+
+  // Lives in the arena. It owns nothing but arena memory and trivially
+  // destructible values, so it is dropped with the arena, never destroyed
+  IdMap* ids_;
+
+  // Point into the arena. The array itself keeps its capacity every day
+  std::vector<std::string_view> names_;
+};
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_CLIENT_NAME_INTERNER_H_
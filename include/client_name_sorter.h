@@ -0,0 +1,62 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Radix sorting of clients by name
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_CLIENT_NAME_SORTER_H_
+#define INCLUDE_CLIENT_NAME_SORTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "include/client_name_interner.h"
+#include "include/client_name_validator.h"
+
+namespace cybercafe_monitoring_system {
+
+// Sorts clients in the ClientsNameCompare order. Names are encoded into
+// character keys once, then sorted by an MSD radix sort over the 38 symbols.
+// The buffers are kept between calls, so a sorter reused every day does not
+// allocate after the busiest one
+class ClientNameSorter final {
+ public:
+  // Names must be valid client names
+  void Sort(std::span<ClientId> clients, const ClientNameInterner& names);
+
+ private:
+  struct Item {
+    uint32_t key_offset;
+
+    uint32_t key_size;
+
+    ClientId client;
+  };
+
+  // Ranges this small are sorted by comparison
+  static constexpr size_t kComparisonSortSize = 32;
+
+  // Sorts items [begin, end), equal in the first depth characters
+  void SortRange(size_t begin, size_t end, size_t depth);
+
+  // Character key at the depth, 0 past the end of the name
+  inline uint8_t KeyAt(const Item& item, size_t depth) const {
+    return depth < item.key_size ? keys_[item.key_offset + depth] : 0;
+  }
+
+  std::vector<uint8_t> keys_;
+
+  std::vector<Item> items_;
+
+  std::vector<Item> scratch_;
+};
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_CLIENT_NAME_SORTER_H_
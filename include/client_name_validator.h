@@ -0,0 +1,77 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Client name alphabet and its vectorized checks
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_CLIENT_NAME_VALIDATOR_H_
+#define INCLUDE_CLIENT_NAME_VALIDATOR_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace cybercafe_monitoring_system {
+
+// Letters, digits, '_' and '-', in this order
+inline constexpr int kClientNameAlphabetSize = 38;
+
+// Order preserving key of every name character: its rank in the alphabet
+// plus one. Zero for the characters that are not allowed in names
+inline constexpr std::array<uint8_t, 256> kClientNameCharacterKeys = [] {
+  std::array<uint8_t, 256> keys{};
+  for (int c = 'a'; c <= 'z'; ++c) keys[c] = static_cast<uint8_t>(c - 'a' + 1);
+  for (int c = '0'; c <= '9'; ++c) keys[c] = static_cast<uint8_t>(c - '0' + 27);
+  keys['_'] = 37;
+  keys['-'] = 38;
+  return keys;
+}();
+
+inline constexpr uint8_t GetClientNameCharacterKey(char c) {
+  return kClientNameCharacterKeys[static_cast<uint8_t>(c)];
+}
+
+// Instruction sets of the checks
+enum class SimdLevel {
+  kScalar,
+  // 16 bytes per step
+  kSse2,
+  // 32 bytes per step
+  kAvx2,
+};
+
+// The widest level supported by both the build and the processor
+SimdLevel GetSupportedSimdLevel();
+
+// Checks every character with the given level, which must be supported
+bool AreClientNameCharactersValid(std::string_view name, SimdLevel level);
+
+// The same with the widest supported level, chosen once
+bool AreClientNameCharactersValid(std::string_view name);
+
+// Names shorter than this are checked by the table, a vector step would not
+// pay for itself
+inline constexpr size_t kClientNameVectorSize = 16;
+
+// Non-empty and made of the alphabet characters only. Does not depend on the
+// locale
+inline bool IsClientNameValid(std::string_view name) {
+  if (name.size() >= kClientNameVectorSize)
+    return AreClientNameCharactersValid(name);
+
+  bool valid = not name.empty();
+  for (char c : name) valid &= GetClientNameCharacterKey(c) != 0;
+  return valid;
+}
+
+// Length of the common prefix of the names, compared 16 or 32 bytes per step
+size_t GetCommonPrefixSize(std::string_view first, std::string_view second);
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_CLIENT_NAME_VALIDATOR_H_
@@ -13,19 +13,33 @@
 
 #include <algorithm>
 #include <chrono>
-#include <deque>
+#include <cstdint>
+#include <format>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <string_view>
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
+
+#include "include/client_name_interner.h"
+#include "include/client_name_sorter.h"
+#include "include/client_name_validator.h"
+#include "include/occupancy_timeline.h"
+#include "include/output_sink.h"
+#include "include/session_ledger.h"
+#include "include/system_instruments.h"
+#include "include/table_occupancy_index.h"
+#include "include/table_stats_store.h"
+#include "include/waiting_queue.h"
 
 namespace cybercafe_monitoring_system {
 
 using TimePoint =
     std::chrono::time_point<std::chrono::system_clock, std::chrono::minutes>;
 
+class CheckpointCodec;
+
 class CybercafeMonitoringSystem final {
  public:
   class Event {
@@ -50,8 +64,8 @@ class CybercafeMonitoringSystem final {
 
     virtual void Handle(CybercafeMonitoringSystem& system) = 0;
 
-    // Prints event header
-    void Print() const;
+    // Prints event header and body
+    void Print(OutputSink& output) const;
 
     inline TimePoint GetTime() const { return time_; }
 
@@ -63,16 +77,8 @@ class CybercafeMonitoringSystem final {
     Event(const TimePoint& time, Id event_id, Type event_type)
         : time_(time), id_(event_id), type_{event_type} {}
 
-    inline static bool IsClientNameValid(std::string_view client_name) {
-      for (char c : client_name)
-        if (not(std::isdigit(c) or std::islower(c) or c == '_' or c == '-'))
-          return false;
-
-      return !client_name.empty();
-    }
-
     // Prints event body
-    virtual void PrintEventBody() const = 0;
+    virtual void PrintEventBody(OutputSink& output) const = 0;
 
     TimePoint time_;
 
@@ -97,8 +103,9 @@ class CybercafeMonitoringSystem final {
     inline std::string GetClientName() const { return client_name_; }
 
    private:
-    inline void PrintEventBody() const override {
-      std::cout << client_name_ << std::endl;
+    inline void PrintEventBody(OutputSink& output) const override {
+      output.Write(client_name_);
+      output.Put('\n');
     }
 
     std::string client_name_;
@@ -125,8 +132,8 @@ class CybercafeMonitoringSystem final {
     inline int GetTableNum() const { return table_id_; }
 
    private:
-    inline void PrintEventBody() const override {
-      std::cout << client_name_ << " " << table_id_ << std::endl;
+    inline void PrintEventBody(OutputSink& output) const override {
+      output.Print("{} {}\n", client_name_, table_id_);
     }
 
     std::string client_name_;
@@ -150,8 +157,9 @@ class CybercafeMonitoringSystem final {
     inline std::string GetClientName() const { return client_name_; }
 
    private:
-    inline void PrintEventBody() const override {
-      std::cout << client_name_ << std::endl;
+    inline void PrintEventBody(OutputSink& output) const override {
+      output.Write(client_name_);
+      output.Put('\n');
     }
 
     std::string client_name_;
@@ -174,8 +182,9 @@ class CybercafeMonitoringSystem final {
     inline std::string GetClientName() const { return client_name_; }
 
    private:
-    inline void PrintEventBody() const override {
-      std::cout << client_name_ << std::endl;
+    inline void PrintEventBody(OutputSink& output) const override {
+      output.Write(client_name_);
+      output.Put('\n');
     }
 
     std::string client_name_;
@@ -187,42 +196,168 @@ class CybercafeMonitoringSystem final {
         : Event(event_time, Id::k13, Type::kOutgoing),
           error_message_(error_message) {}
 
-    inline void Handle(CybercafeMonitoringSystem&) override { Print(); };
+    inline void Handle(CybercafeMonitoringSystem& system) override {
+      Print(*system.output_);
+    };
 
     inline std::string What() const { return error_message_; }
 
    private:
-    inline void PrintEventBody() const override {
-      std::cout << error_message_ << std::endl;
+    inline void PrintEventBody(OutputSink& output) const override {
+      output.Write(error_message_);
+      output.Put('\n');
     }
 
     std::string error_message_;
   };
 
+  // Compact form of an event: 16 bytes, no heap data and no vtable, so a day
+  // of events fits in one contiguous buffer. The client is an id interned by
+  // the system the record was made for and is valid until it closes
+  struct EventRecord {
+    // Minutes since midnight
+    int32_t minutes = 0;
+
+    Event::Id id = Event::Id::kBadId;
+
+    ClientId client = kNoClient;
+
+    // Table id for k2 and k12, 0 otherwise
+    int32_t table_id = 0;
+  };
+
+  // A line the system prints, kept as data while output records are set
+  struct OutputRecord {
+    enum class Kind : uint8_t {
+      // Opening or closing time
+      kTime,
+      // Event line of PrintEventRecord
+      kEvent,
+      // k13 line
+      kError,
+      // Table line of PrintClosingStats
+      kTableStats,
+    };
+
+    Kind kind = Kind::kTime;
+
+    Event::Id id = Event::Id::kBadId;
+
+    ErrorReason reason = ErrorReason::kYouShallNotPass;
+
+    int32_t minutes = 0;
+
+    int32_t table_id = 0;
+
+    // Client name of kEvent in OutputRecords::names
+    uint32_t name_offset = 0;
+
+    uint32_t name_size = 0;
+
+    int64_t revenue = 0;
+
+    int64_t used_minutes = 0;
+  };
+
+  // Output records in the order they were made. Names are copied, so the
+  // records stay valid after the system forgets its clients
+  struct OutputRecords {
+    std::vector<OutputRecord> records;
+
+    std::string names;
+
+    inline void Clear() {
+      records.clear();
+      names.clear();
+    }
+  };
+
+  // For sorting clients names. The equal prefix is skipped 16 or 32 bytes per
+  // step, the first different characters are ranked by the alphabet table
+  class ClientsNameCompare final {
+   public:
+    bool operator()(std::string_view first, std::string_view second) const {
+      const size_t prefix_size = GetCommonPrefixSize(first, second);
+      if (prefix_size == first.size() or prefix_size == second.size())
+        return first.size() < second.size();
+
+      return CharacterRank(first[prefix_size]) <
+             CharacterRank(second[prefix_size]);
+    }
+
+   private:
+    inline static int CharacterRank(char c) {
+      if (const uint8_t key = GetClientNameCharacterKey(c); key != 0)
+        return key - 1;
+
+      throw std::runtime_error(
+          std::format("Invalid character in client name: {}", c));
+    }
+  };
+
+  // Output goes to std::cout
   CybercafeMonitoringSystem(const TimePoint& opening_time,
                             const TimePoint& closing_time, int tables_count,
                             int hourly_rate);
 
-  // Remove this if you plan to modify the prototype for real-time use
+  // Output goes to the given sink, which must outlive the system
+  CybercafeMonitoringSystem(const TimePoint& opening_time,
+                            const TimePoint& closing_time, int tables_count,
+                            int hourly_rate, OutputSink& output);
+
+  // Called before the first event of an input or, in the live mode, by the
+  // clock at the opening time
   inline void StartWorkDayTrigger() { CybercafeOpen(); };
 
-  // Remove this if you plan to modify the prototype for real-time use
+  // Called after the last event of an input or, in the live mode, by the
+  // clock at the closing time
   inline void EndWorkDayTrigger() { CybercafeClose(); };
 
+  // Makes the record of an incoming event, interning the client name. Throws
+  // std::invalid_argument if the name or the id is incorrect
+  EventRecord MakeEventRecord(const TimePoint& time, Event::Id id,
+                              std::string_view client_name, int table_id = 0);
+
+  // Prints the record and handles it like the matching event class would
+  void Handle(const EventRecord& record);
+
+  // Prints record header and body
+  void PrintEventRecord(const EventRecord& record) const;
+
   // Prints the desk number, its revenue for the day and the time it was
   // occupied during the working day
   void PrintClosingStats() const;
 
+  // While set, everything the system prints is appended to the records
+  // instead and the output sink is not used, not even flushed at the closing
+  // time. PrintOutputRecords prints them as the system would have, e.g. on
+  // another thread. nullptr prints to the sink again
+  inline void SetOutputRecords(OutputRecords* records) {
+    output_records_ = records;
+  }
+
+  // Prints the records in their order
+  static void PrintOutputRecords(const OutputRecords& records,
+                                 OutputSink& output);
+
   inline bool IsWorking(const TimePoint& time) const {
     return time >= opening_time_ and time < closing_time_;
   }
 
   inline bool IsAvailableTableExists() const {
-    return clients_at_table_.size() < static_cast<size_t>(tables_count_);
+    return tables_occupancy_.GetOccupiedCount() < tables_count_;
   }
 
   bool IsTableFree(int table_id) const;
 
+  // Returns the client sitting at the table or an empty name if it is free
+  std::string_view GetTableOccupant(int table_id) const;
+
+  // Returns the smallest free table id or 0 if all tables are occupied
+  inline int FindFirstFreeTable() const {
+    return tables_occupancy_.FindFirstFreeTable();
+  }
+
 #if 0
   // For future
 
@@ -235,55 +370,123 @@ class CybercafeMonitoringSystem final {
 #endif
   inline int64_t GetTotalRevenue() const { return total_revenue_; }
 
-  int hourly_rate_;
+  // Calls visit(client name) for every waiting client from the front
+  template <typename Visit>
+  void ForEachWaitingClient(Visit&& visit) const {
+    waiting_clients_.ForEach(
+        [&](ClientId client) { visit(client_names_.GetName(client)); });
+  }
 
- private:
-  // For sorting clients names
-  class ClientsNameCompare final {
-   public:
-    bool operator()(std::string_view first, std::string_view second) const {
-      if (first == second) return false;
+  // Statistics of the current day, kept after closing until the next opening
+  inline const TableStatsStore& GetTablesStats() const { return tables_stats_; }
 
-      for (size_t i = 0, iend = std::min(first.size(), second.size());
-           i != iend; ++i) {
-        const int first_rank = CharacterRank(first[i]),
-                  second_rank = CharacterRank(second[i]);
-        if (first_rank != second_rank) return first_rank < second_rank;
-      }
+  // Occupied tables and waiting clients of every minute of the current day,
+  // kept after closing until the next opening
+  inline const OccupancyTimeline& GetOccupancyTimeline() const {
+    return occupancy_timeline_;
+  }
 
-      return first.size() < second.size();
-    }
+  // Every session of the current day with its charge, kept after closing
+  // until the next opening
+  inline const SessionLedger& GetSessionLedger() const {
+    return session_ledger_;
+  }
 
-   private:
-    inline static int CharacterRank(char c) {
-      if (c >= 'a' and c <= 'z')
-        return c - 'a';
-      else if (c >= '0' and c <= '9')
-        return 26 + (c - '0');
-      else if (c == '_')
-        return 36;
-      else if (c == '-')
-        return 37;
+  inline OutputSink& GetOutputSink() const { return *output_; }
 
-      throw std::runtime_error(
-          std::format("Invalid character in client name: {}", c));
-    }
-  };
+  // Hot path counters of the current day, kept after closing until the next
+  // opening. All zero unless built with CYBERCAFE_INSTRUMENTATION
+  inline InstrumentsSnapshot GetInstrumentsSnapshot() const {
+    return instruments_.GetSnapshot();
+  }
+
+  // Where the counters are printed when the cybercafe closes, std::cerr if
+  // not set. Does nothing unless built with CYBERCAFE_INSTRUMENTATION
+  inline void SetInstrumentsReport(OutputSink* report) {
+    instruments_.SetReport(report);
+  }
+
+  int hourly_rate_;
+
+ private:
+  CybercafeMonitoringSystem(const TimePoint& opening_time,
+                            const TimePoint& closing_time, int tables_count,
+                            int hourly_rate, OutputSink* output);
+
+  inline static bool IsClientNameValid(std::string_view client_name) {
+    return cybercafe_monitoring_system::IsClientNameValid(client_name);
+  }
+
+  inline static TimePoint ToTimePoint(int32_t minutes) {
+    return TimePoint{std::chrono::minutes{minutes}};
+  }
 
   friend ClientArrivedEvent;
   friend ClientLeftEvent;
   friend ClientSatAtTableEvent;
   friend ClientWaitingEvent;
 
+  // Saves and restores the whole state
+  friend CheckpointCodec;
+
   // Calls when the cybercafe opens
   void CybercafeOpen();
 
   // Calls when the cybercafe closes
   void CybercafeClose();
 
+  // Prints k11 for every client still inside, in the name order, and ends
+  // all open sessions at the closing time in one pass over the tables
+  void SettleRemainingClients();
+
+  // Per-client state, indexed by the interned client id
+  struct ClientState {
+    // Table the client sits at, 0 if none
+    int table_id = 0;
+
+    // The client came in during working hours and has not left yet
+    bool inside = false;
+  };
+
+  // Returns the client id, one hash lookup per call
+  inline ClientId InternClient(std::string_view client_name) {
+    ClientId client = client_names_.Intern(client_name);
+    if (client >= clients_.size()) clients_.resize(client + 1);
+    return client;
+  }
+
+  // Record of an already validated event, used by the event classes
+  inline EventRecord MakeRecord(const TimePoint& time, Event::Id id,
+                                std::string_view client_name, int table_id) {
+    return EventRecord{static_cast<int32_t>(time.time_since_epoch().count()),
+                       id, InternClient(client_name), table_id};
+  }
+
+  void HandleClientArrived(const EventRecord& record);
+
+  void HandleClientSatAtTable(const EventRecord& record);
+
+  void HandleClientWaiting(const EventRecord& record);
+
+  void HandleClientLeft(const EventRecord& record);
+
+  // Prints k13 with the reason
+  void PrintError(int32_t minutes, ErrorReason reason);
+
+  // Prints the opening or the closing time line
+  void PrintTime(const TimePoint& time) const;
+
   // Deletes client from database
-  void ProcessClientDeparture(const std::string& client_name,
-                              const TimePoint& time);
+  void ProcessClientDeparture(ClientId client, const TimePoint& time);
+
+  // Set when no sink is given to the constructor
+  std::unique_ptr<OutputSink> own_output_;
+
+  // Everything the system prints goes here. Flushed at the end of the day
+  OutputSink* output_;
+
+  // Takes the place of output_ when set
+  OutputRecords* output_records_ = nullptr;
 
   TimePoint opening_time_, closing_time_;
 
@@ -291,22 +494,34 @@ class CybercafeMonitoringSystem final {
 
   int64_t total_revenue_ = 0;
 
-  std::deque<std::string> waiting_clients_{};
+  WaitingQueue waiting_clients_{};
 
-  // You can change it into a database
-  std::unordered_set<std::string> clients_{};
+  // Every name seen during the day. Cleared when the cybercafe closes
+  ClientNameInterner client_names_;
 
   // You can change it into a database
-  std::unordered_map<std::string, int> clients_at_table_{};
+  std::vector<ClientState> clients_{};
 
-  // You can change it into a database
-  std::unordered_map<int, TimePoint> tables_current_using_since_;
+  // Which tables are busy and who sits there, kept in sync with clients_
+  TableOccupancyIndex tables_occupancy_;
 
-  // You can change it into a database
-  std::unordered_map<int, std::chrono::minutes> tables_daily_using_;
+  // Session start, used time and revenue of every table for the day
+  TableStatsStore tables_stats_;
 
-  // You can change it into a database
-  std::unordered_map<int, int64_t> tables_daily_revenue_;
+  // Occupied tables and waiting clients of every minute of the day
+  OccupancyTimeline occupancy_timeline_;
+
+  // Sessions of the day in the order they ended. Like the printed output, it
+  // is not saved in checkpoints
+  SessionLedger session_ledger_;
+
+  // Clients inside at the closing time and their sorter, reused every day
+  std::vector<ClientId> remaining_clients_;
+
+  ClientNameSorter remaining_clients_sorter_;
+
+  // Empty unless built with CYBERCAFE_INSTRUMENTATION
+  [[no_unique_address]] SystemInstruments instruments_;
 };
 
 }  // namespace cybercafe_monitoring_system
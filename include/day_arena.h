@@ -0,0 +1,94 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Monotonic memory for the state of one day
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_DAY_ARENA_H_
+#define INCLUDE_DAY_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace cybercafe_monitoring_system {
+
+// Hands out memory by bumping a pointer through blocks taken from the
+// upstream resource. Deallocation does nothing, everything is released at
+// once by Reset, which rewinds to the first block in O(1). Blocks are kept
+// for the next day, so once a day fits nothing more is asked from the
+// upstream. Not thread safe
+class DayArena final : public std::pmr::memory_resource {
+ public:
+  explicit DayArena(
+      size_t first_block_size = 64 * 1024,
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+  DayArena(const DayArena&) = delete;
+  DayArena& operator=(const DayArena&) = delete;
+
+  ~DayArena() override;
+
+  // Makes all the memory handed out so far free again. Objects in it are not
+  // destroyed
+  inline void Reset() {
+    block_ = 0;
+    position_ = blocks_.empty() ? nullptr : blocks_.front().data;
+    end_ = blocks_.empty() ? nullptr : position_ + blocks_.front().size;
+  }
+
+  // Bytes of all the blocks taken from the upstream
+  size_t GetCapacity() const;
+
+ private:
+  struct Block {
+    std::byte* data;
+
+    size_t size;
+  };
+
+  inline void* do_allocate(size_t bytes, size_t alignment) override {
+    const auto position = reinterpret_cast<uintptr_t>(position_);
+    const uintptr_t aligned = (position + alignment - 1) & ~(alignment - 1);
+    if (position_ != nullptr and
+        aligned + bytes <= reinterpret_cast<uintptr_t>(end_)) {
+      position_ += aligned - position + bytes;
+      return position_ - bytes;
+    }
+    return AllocateInNextBlock(bytes, alignment);
+  }
+
+  inline void do_deallocate(void*, size_t, size_t) override {}
+
+  inline bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  // Moves on to the first kept block after the current one that fits the
+  // allocation, or takes a new one from the upstream
+  void* AllocateInNextBlock(size_t bytes, size_t alignment);
+
+  std::pmr::memory_resource* upstream_;
+
+  size_t first_block_size_;
+
+  std::vector<Block> blocks_;
+
+  // Index of the block being filled
+  size_t block_ = 0;
+
+  // Free part of that block
+  std::byte* position_ = nullptr;
+
+  std::byte* end_ = nullptr;
+};
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_DAY_ARENA_H_
@@ -0,0 +1,71 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Synthetic day logs for load testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_DAY_LOG_GENERATOR_H_
+#define INCLUDE_DAY_LOG_GENERATOR_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "include/cybercafe_monitoring_system.h"
+#include "include/output_sink.h"
+
+namespace cybercafe_monitoring_system {
+
+enum class ArrivalDistribution {
+  // The same arrival rate for the whole day
+  kPoisson,
+  // Most clients come around lunch and in the evening
+  kRushHour,
+};
+
+struct DayLogOptions {
+  // The same options and seed always give the same log
+  uint64_t seed = 1;
+
+  int tables_count = 10;
+
+  TimePoint opening_time{std::chrono::minutes{9 * 60}};
+
+  TimePoint closing_time{std::chrono::minutes{21 * 60}};
+
+  int hourly_rate = 10;
+
+  // Approximate number of event lines
+  uint64_t events_count = 1000;
+
+  ArrivalDistribution arrivals = ArrivalDistribution::kPoisson;
+
+  double mean_session_minutes = 90;
+
+  // Chance that a client who finds no free table asks to wait instead of
+  // leaving
+  double wait_ratio = 0.5;
+
+  // Share of events that are deliberately wrong and get a k13 answer
+  double error_ratio = 0.02;
+};
+
+// Writes a valid input file in the README format. Events are produced minute
+// by minute while simulating the tables, so memory depends on the tables
+// count only, not on the log size. Returns the number of event lines
+uint64_t GenerateDayLog(const DayLogOptions& options, OutputSink& output);
+
+// Writes venue<v>_day<d>.txt for every venue and day into the directory, in
+// parallel. Each file has its own seed derived from options.seed. Returns the
+// file paths in venue then day order
+std::vector<std::filesystem::path> GenerateVenueDays(
+    const DayLogOptions& options, int venues_count, int days_count,
+    const std::filesystem::path& output_dir);
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_DAY_LOG_GENERATOR_H_
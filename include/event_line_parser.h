@@ -0,0 +1,53 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Allocation-free parsing of input data lines
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_EVENT_LINE_PARSER_H_
+#define INCLUDE_EVENT_LINE_PARSER_H_
+
+#include <string_view>
+
+#include "include/cybercafe_monitoring_system.h"
+
+namespace cybercafe_monitoring_system {
+
+// Event line fields. The client name points into the parsed line
+struct ParsedEventLine {
+  TimePoint time;
+
+  CybercafeMonitoringSystem::Event::Id id =
+      CybercafeMonitoringSystem::Event::Id::kBadId;
+
+  std::string_view client_name;
+
+  int table_id = 0;
+};
+
+// Cuts the next line off the front of the text, without the '\n'
+std::string_view NextLine(std::string_view& text);
+
+// Cuts the next whitespace separated token off the front of the text. Returns
+// an empty token if there is none
+std::string_view NextToken(std::string_view& text);
+
+// Reads time in HH:MM format. Throws std::invalid_argument on bad format
+TimePoint ParseTime(std::string_view token);
+
+// Reads a whole token as a decimal number. Throws std::invalid_argument if the
+// token is not a number
+int ParseInt(std::string_view token);
+
+// Reads "<HH:MM> <id> <client name> [table]" without copying the line. Throws
+// std::invalid_argument if some field is missing or incorrect. The client name
+// is not validated here, the event constructors do it
+ParsedEventLine ParseEventLine(std::string_view line);
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_EVENT_LINE_PARSER_H_
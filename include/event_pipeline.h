@@ -0,0 +1,54 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Event handling pipelined over a parsing, a handling and a printing thread
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_EVENT_PIPELINE_H_
+#define INCLUDE_EVENT_PIPELINE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "include/cybercafe_monitoring_system.h"
+#include "include/output_sink.h"
+
+namespace cybercafe_monitoring_system {
+
+struct EventPipelineOptions {
+  // Events or output records passed between the threads at once
+  size_t block_size = 4096;
+
+  // Blocks between two threads, the rest wait until one is released
+  size_t blocks_in_flight = 8;
+};
+
+struct EventPipelineResult {
+  uint64_t events = 0;
+
+  // The event after the handled ones is earlier than the previous one. It is
+  // printed, not handled, as the single-threaded processing does
+  bool order_violated = false;
+};
+
+// Handles the event lines of the text with the same output as one thread
+// handling them in order. A second thread parses the lines and checks their
+// order, the calling thread interns the names and handles the events with the
+// system's output kept as records, a third thread prints the records. Blocks
+// go between the threads through bounded lock-free SPSC queues and come back
+// empty, so the threads overlap and no block is allocated twice. Everything is
+// printed to the output when the function returns or throws. On an incorrect
+// line file_line is set to it and its exception is rethrown
+EventPipelineResult HandleEventsPipelined(
+    CybercafeMonitoringSystem& system, std::string_view text,
+    std::string_view& file_line, OutputSink& output,
+    const EventPipelineOptions& options = {});
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_EVENT_PIPELINE_H_
@@ -0,0 +1,79 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Fixed size latency histogram
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_LATENCY_HISTOGRAM_H_
+#define INCLUDE_LATENCY_HISTOGRAM_H_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace cybercafe_monitoring_system {
+
+// Counts durations in log-linear buckets: every power of two is split into
+// kSubBuckets equal parts, so a percentile is off by at most 1/kSubBuckets.
+// Recording is a few integer operations and never allocates
+class LatencyHistogram final {
+ public:
+  static constexpr int kSubBucketBits = 3;
+
+  static constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+
+  inline void Record(std::chrono::nanoseconds duration) {
+    const auto value =
+        static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+    ++counts_[BucketIndex(value)];
+    ++total_count_;
+  }
+
+  void Merge(const LatencyHistogram& other);
+
+  // Upper bound of the bucket holding the given share of the recorded values,
+  // e.g. 0.99 for p99. Zero if nothing is recorded
+  std::chrono::nanoseconds Percentile(double share) const;
+
+  inline uint64_t GetCount() const { return total_count_; }
+
+  inline void Clear() { *this = LatencyHistogram{}; }
+
+ private:
+  // Values below kSubBuckets get their own buckets, larger ones share a
+  // bucket with values of the same top kSubBucketBits + 1 bits
+  static constexpr size_t kBucketsCount =
+      (64 - kSubBucketBits + 1) * kSubBuckets;
+
+  inline static size_t BucketIndex(uint64_t value) {
+    if (value < kSubBuckets) return static_cast<size_t>(value);
+
+    const int exponent = std::bit_width(value) - 1 - kSubBucketBits;
+    const uint64_t sub_bucket = (value >> exponent) - kSubBuckets;
+    return static_cast<size_t>((exponent + 1) * kSubBuckets + sub_bucket);
+  }
+
+  // Largest value that falls into the bucket
+  inline static uint64_t BucketUpperBound(size_t index) {
+    if (index < kSubBuckets) return index;
+
+    const auto exponent = static_cast<int>(index / kSubBuckets) - 1;
+    const uint64_t sub_bucket = index % kSubBuckets;
+    return ((kSubBuckets + sub_bucket + 1) << exponent) - 1;
+  }
+
+  std::array<uint64_t, kBucketsCount> counts_{};
+
+  uint64_t total_count_ = 0;
+};
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_LATENCY_HISTOGRAM_H_
@@ -0,0 +1,164 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Real-time event ingestion from terminals over a local socket
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_LIVE_SERVER_H_
+#define INCLUDE_LIVE_SERVER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "include/cybercafe_monitoring_system.h"
+#include "include/latency_histogram.h"
+#include "include/output_sink.h"
+
+namespace cybercafe_monitoring_system {
+
+struct LiveServerOptions {
+  std::filesystem::path socket_path;
+
+  // Current time of day. The local wall clock if not set
+  std::function<TimePoint()> clock;
+
+  // Lines handled in one wakeup over all connections. A connection with lines
+  // left is not read until they are handled, so once the socket buffer fills
+  // up its terminal blocks on writing
+  size_t max_lines_per_wakeup = 1024;
+
+  // Unhandled input kept per connection, the longest accepted line
+  size_t max_connection_buffer = size_t{1} << 16;
+};
+
+// Counters of one server run
+struct LiveStats {
+  uint64_t connections = 0;
+
+  uint64_t handled_events = 0;
+
+  // Incorrect lines and events out of time order
+  uint64_t rejected_events = 0;
+
+  // Times a connection was not read because the server fell behind
+  uint64_t paused_connections = 0;
+
+  // From reading the line off the socket to flushing its output
+  LatencyHistogram latency;
+};
+
+// Terminals connect to a Unix-domain socket and write event lines in the
+// input file format. The time may be omitted, then the event gets the current
+// time. Every line is handled as soon as it is read and its output is flushed
+// before the next wait. The day opens and closes by the clock. Linux only
+class LiveServer final {
+ public:
+  // Binds the socket, replacing a stale one. The system must outlive the
+  // server
+  LiveServer(CybercafeMonitoringSystem& system,
+             const LiveServerOptions& options);
+
+  LiveServer(const LiveServer&) = delete;
+  LiveServer& operator=(const LiveServer&) = delete;
+
+  ~LiveServer();
+
+  // Polls until Stop is called, then closes an open day
+  void Run();
+
+  // Waits for input at most max_wait, handles it and flushes the output.
+  // Opens or closes the day if the clock says so. Returns false once stopped
+  bool Poll(std::chrono::milliseconds max_wait);
+
+  // Safe to call from another thread or a signal handler
+  void Stop();
+
+  inline bool IsDayOpen() const { return day_open_; }
+
+  inline const LiveStats& GetStats() const { return stats_; }
+
+ private:
+  using SteadyClock = std::chrono::steady_clock;
+
+  struct Connection {
+    int fd = -1;
+
+    std::string buffer;
+
+    // Received times of the read chunks still in the buffer, with the
+    // buffer offsets they end at
+    std::vector<std::pair<size_t, SteadyClock::time_point>> chunks;
+
+    bool paused = false;
+
+    bool peer_closed = false;
+  };
+
+  void OpenOrCloseDay();
+
+  void AcceptConnections();
+
+  // Reads what fits into the connection buffer
+  void ReadConnection(Connection& connection);
+
+  // Handles complete lines while the budget lasts. Returns true if complete
+  // lines are left
+  bool HandleLines(Connection& connection, size_t& budget);
+
+  // Returns false if the line is rejected
+  bool HandleLine(std::string_view line);
+
+  // Stops reading the connection while it has lines left by the budget
+  void UpdateInterest(Connection& connection, bool lines_left);
+
+  void CloseConnection(int fd);
+
+  void CloseDescriptors();
+
+  CybercafeMonitoringSystem& system_;
+
+  LiveServerOptions options_;
+
+  int listen_fd_ = -1;
+
+  int stop_fd_ = -1;
+
+  int epoll_fd_ = -1;
+
+  std::unordered_map<int, Connection> connections_;
+
+  // Received times of the lines handled since the last flush
+  std::vector<SteadyClock::time_point> unflushed_;
+
+  std::optional<int32_t> previous_event_time_;
+
+  bool day_open_ = false;
+
+  bool pending_lines_ = false;
+
+  std::atomic<bool> stopped_ = false;
+
+  LiveStats stats_;
+};
+
+// Prints "events <handled> rejected <count> paused <count> latency p50 <us>
+// p99 <us>"
+void PrintLiveStats(const LiveStats& stats, OutputSink& output);
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_LIVE_SERVER_H_
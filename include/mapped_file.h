@@ -0,0 +1,54 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Read-only memory mapped file
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_MAPPED_FILE_H_
+#define INCLUDE_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace cybercafe_monitoring_system {
+
+// Maps the whole file into memory for reading. The kernel is advised that the
+// mapping is read sequentially, so it can read ahead aggressively
+class MappedFile final {
+ public:
+  explicit MappedFile(const std::filesystem::path& file_path);
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  ~MappedFile();
+
+  inline std::string_view View() const { return {data_, size_}; }
+
+  inline size_t Size() const { return size_; }
+
+ private:
+  void Unmap() noexcept;
+
+  const char* data_ = nullptr;
+
+  size_t size_ = 0;
+
+#ifdef _WIN32
+  void* file_handle_ = nullptr;
+
+  void* mapping_handle_ = nullptr;
+#endif
+};
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_MAPPED_FILE_H_
@@ -0,0 +1,111 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Per-minute occupancy of the cybercafe during the day
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_OCCUPANCY_TIMELINE_H_
+#define INCLUDE_OCCUPANCY_TIMELINE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cybercafe_monitoring_system {
+
+// A count for every minute of the day. Changes go into a difference array in
+// O(1). The counts, their prefix sums and a sparse table of maxima are rebuilt
+// once on the first query after a change, then every range query is O(1)
+class MinuteSeries final {
+ public:
+  static constexpr int32_t kMinutesPerDay = 24 * 60;
+
+  MinuteSeries();
+
+  // Adds delta to the count from the minute to the end of the day
+  inline void Add(int32_t minute, int32_t delta) {
+    differences_[static_cast<size_t>(minute)] += delta;
+    finalized_ = false;
+  }
+
+  // Zeroes the counts without reallocating
+  void Reset();
+
+  // Count during the minute. Throws std::invalid_argument if the minute is
+  // out of the day
+  int32_t GetAt(int32_t minute) const;
+
+  // Average count over minutes [from, to). Throws std::invalid_argument
+  // unless 0 <= from < to <= kMinutesPerDay
+  double GetAverage(int32_t from, int32_t to) const;
+
+  // Largest count over minutes [from, to), with the same bounds
+  int32_t GetPeak(int32_t from, int32_t to) const;
+
+  // Visits (minute, delta) of every change in the minute order
+  template <typename Visitor>
+  void ForEachChange(Visitor&& visitor) const {
+    for (int32_t minute = 0; minute != kMinutesPerDay; ++minute)
+      if (const int32_t delta = differences_[static_cast<size_t>(minute)];
+          delta != 0)
+        visitor(minute, delta);
+  }
+
+ private:
+  // Levels of the sparse table, the longest range is the whole day
+  static constexpr size_t kLevels = 11;
+
+  void Finalize() const;
+
+  void CheckRange(int32_t from, int32_t to) const;
+
+  std::vector<int32_t> differences_;
+
+  mutable bool finalized_ = false;
+
+  // prefix_sums_[m] is the sum of the counts of minutes [0, m)
+  mutable std::vector<int64_t> prefix_sums_;
+
+  // maxima_[level * kMinutesPerDay + m] is the largest count of minutes
+  // [m, m + 2^level)
+  mutable std::vector<int32_t> maxima_;
+};
+
+// Occupied tables and waiting clients for every minute of the day, updated by
+// the handlers as the changes happen
+class OccupancyTimeline final {
+ public:
+  inline void ChangeOccupiedTables(int32_t minute, int32_t delta) {
+    occupied_tables_.Add(minute, delta);
+  }
+
+  inline void ChangeWaitingClients(int32_t minute, int32_t delta) {
+    waiting_clients_.Add(minute, delta);
+  }
+
+  inline void Reset() {
+    occupied_tables_.Reset();
+    waiting_clients_.Reset();
+  }
+
+  inline const MinuteSeries& GetOccupiedTables() const {
+    return occupied_tables_;
+  }
+
+  inline const MinuteSeries& GetWaitingClients() const {
+    return waiting_clients_;
+  }
+
+ private:
+  MinuteSeries occupied_tables_;
+
+  MinuteSeries waiting_clients_;
+};
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_OCCUPANCY_TIMELINE_H_
@@ -0,0 +1,195 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Buffered output destinations of the cybercafe monitoring system
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_OUTPUT_SINK_H_
+#define INCLUDE_OUTPUT_SINK_H_
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace cybercafe_monitoring_system {
+
+// Collects the output text in a large buffer and passes it to the backend
+// only when the buffer is full or on explicit Flush
+class OutputSink {
+ public:
+  static constexpr size_t kDefaultBufferSize = size_t{1} << 16;
+
+  explicit OutputSink(size_t buffer_size = kDefaultBufferSize)
+      : buffer_size_(buffer_size) {
+    buffer_.reserve(buffer_size_);
+  }
+
+  OutputSink(const OutputSink&) = delete;
+  OutputSink& operator=(const OutputSink&) = delete;
+
+  // Backends flush the remaining text in their own destructors. A destructor
+  // cannot report a failed write, so callers that need to know Flush first
+  virtual ~OutputSink() = default;
+
+  inline void Write(std::string_view text) {
+    buffer_.append(text);
+    if (buffer_.size() >= buffer_size_) Drain();
+  }
+
+  inline void Put(char c) {
+    buffer_.push_back(c);
+    if (buffer_.size() >= buffer_size_) Drain();
+  }
+
+  template <typename... Args>
+  void Print(std::format_string<Args...> format, Args&&... args) {
+    std::format_to(std::back_inserter(buffer_), format,
+                   std::forward<Args>(args)...);
+    if (buffer_.size() >= buffer_size_) Drain();
+  }
+
+  // Passes buffered text to the backend and makes the backend publish it
+  void Flush() {
+    Drain();
+    Sync();
+  }
+
+ protected:
+  // Writes the text to the final destination
+  virtual void Consume(std::string_view data) = 0;
+
+  // Publishes everything consumed so far
+  virtual void Sync() {}
+
+ private:
+  inline void Drain() {
+    if (buffer_.empty()) return;
+    Consume(buffer_);
+    buffer_.clear();
+  }
+
+  size_t buffer_size_;
+
+  std::string buffer_;
+};
+
+// Writes to a standard stream, e.g. std::cout
+class StreamOutputSink final : public OutputSink {
+ public:
+  explicit StreamOutputSink(std::ostream& stream,
+                            size_t buffer_size = kDefaultBufferSize)
+      : OutputSink(buffer_size), stream_(stream) {}
+
+  ~StreamOutputSink() override { Flush(); }
+
+ private:
+  void Consume(std::string_view data) override;
+
+  void Sync() override;
+
+  std::ostream& stream_;
+};
+
+// Writes to a file with one write call per full buffer
+class FileOutputSink final : public OutputSink {
+ public:
+  explicit FileOutputSink(const std::filesystem::path& file_path,
+                          size_t buffer_size = kDefaultBufferSize);
+
+  // Flushes and closes the file if Close was not called, ignoring errors
+  ~FileOutputSink() override;
+
+  // Flushes and closes the file. Throws std::runtime_error if the output could
+  // not be written completely
+  void Close();
+
+ private:
+  void Consume(std::string_view data) override;
+
+  void Sync() override;
+
+  std::FILE* file_ = nullptr;
+};
+
+// Keeps the whole output in memory
+class MemoryOutputSink final : public OutputSink {
+ public:
+  explicit MemoryOutputSink(size_t buffer_size = kDefaultBufferSize)
+      : OutputSink(buffer_size) {}
+
+  ~MemoryOutputSink() override { Flush(); }
+
+  // Returns everything written so far
+  inline std::string_view View() {
+    Flush();
+    return data_;
+  }
+
+  inline void Clear() {
+    Flush();
+    data_.clear();
+  }
+
+ private:
+  inline void Consume(std::string_view data) override { data_.append(data); }
+
+  std::string data_;
+};
+
+// Copies the output into a memory mapped file that grows in large steps. The
+// file is truncated to the written size when the sink is destroyed. Falls back
+// to FileOutputSink behaviour where memory mapping is not available
+class MappedFileOutputSink final : public OutputSink {
+ public:
+  explicit MappedFileOutputSink(const std::filesystem::path& file_path,
+                                size_t buffer_size = kDefaultBufferSize);
+
+  // Flushes and truncates the file, ignoring errors
+  ~MappedFileOutputSink() override;
+
+ private:
+  void Consume(std::string_view data) override;
+
+  void Sync() override;
+
+#ifdef _WIN32
+  std::FILE* file_ = nullptr;
+#else
+  // Makes the file and the mapping at least required_size bytes long
+  void Reserve(size_t required_size);
+
+  int fd_ = -1;
+
+  char* data_ = nullptr;
+
+  size_t mapped_size_ = 0;
+
+  size_t written_size_ = 0;
+#endif
+};
+
+// Drops the output. Formatting still happens, so benchmarks measure it
+class NullOutputSink final : public OutputSink {
+ public:
+  explicit NullOutputSink(size_t buffer_size = kDefaultBufferSize)
+      : OutputSink(buffer_size) {}
+
+  ~NullOutputSink() override { Flush(); }
+
+ private:
+  inline void Consume(std::string_view) override {}
+};
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_OUTPUT_SINK_H_
@@ -0,0 +1,55 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Event lines parsed in chunks on several threads
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_PARALLEL_EVENT_PARSER_H_
+#define INCLUDE_PARALLEL_EVENT_PARSER_H_
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "include/event_line_parser.h"
+
+namespace cybercafe_monitoring_system {
+
+struct ParallelParseOptions {
+  // 0 means one per hardware thread
+  size_t threads_count = 0;
+
+  // Text bytes of a chunk, which then runs to the end of its last line
+  size_t chunk_size = size_t{1} << 20;
+};
+
+struct ParallelParseResult {
+  // Every event before the first incorrect line, in the text order
+  std::vector<ParsedEventLine> events;
+
+  // First line that is not a correct event, with its client name checked too
+  std::optional<std::string_view> incorrect_line;
+
+  // Index of the first event earlier than the one before it, the events count
+  // if they are in order. Not checked if there is an incorrect line
+  size_t order_violation = 0;
+};
+
+// Splits the text into chunks of whole lines and parses them on a thread pool,
+// each chunk into its own array. The order inside every chunk is checked while
+// parsing, the arrays are then copied into one in parallel and the order is
+// checked across the chunk borders. Chunks after an incorrect line stop early
+ParallelParseResult ParseEventLinesParallel(
+    std::string_view text, const ParallelParseOptions& options = {});
+
+// The whole line of the text that contains the character
+std::string_view GetLineAround(std::string_view text, const char* character);
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_PARALLEL_EVENT_PARSER_H_
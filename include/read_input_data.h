@@ -11,13 +11,148 @@
 #ifndef INCLUDE_READ_INPUT_DATA_H_
 #define INCLUDE_READ_INPUT_DATA_H_
 
-#include <fstream>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <span>
+#include <stdexcept>
+
+#include "include/cybercafe_monitoring_system.h"
+#include "include/output_sink.h"
 
 namespace cybercafe_monitoring_system_test {
 
+enum class InputMode {
+  // All events are read and order-checked before the first one is handled
+  kBuffered,
+  // Every event is order-checked against the previous one and handled right
+  // after it is read, so memory does not depend on the input size. Output of
+  // the events preceding an incorrect line has already been printed
+  kStreaming,
+};
+
+// Time spent in every phase of one run
+struct ProcessingStats {
+  uint64_t events = 0;
+
+  // Header and events reading, with the order check in InputMode::kBuffered
+  std::chrono::nanoseconds read{0};
+
+  std::chrono::nanoseconds open{0};
+
+  // Events handling, with their reading in the streaming modes
+  std::chrono::nanoseconds handle{0};
+
+  std::chrono::nanoseconds close{0};
+};
+
+struct CheckpointOptions {
+  std::filesystem::path path;
+
+  // Events handled between two checkpoints
+  uint64_t interval_events = 100000;
+};
+
+// Thrown after the event that breaks the chronological order is printed
+class EventsOrderViolation final : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
 // Reading CybercafeMonitoringSystem constructor arguments and events arguments
-// from file. To understand the order of arguments in file, see README.md
-void ProcessingInputData(std::ifstream& file);
+// from file. To understand the order of arguments in file, see README.md.
+// Output goes to std::cout
+void ProcessingInputData(std::istream& file,
+                         InputMode mode = InputMode::kBuffered);
+
+// The same, output goes to the given sink. Phase times are added to the
+// stats if they are given
+void ProcessingInputData(std::istream& file,
+                         cybercafe_monitoring_system::OutputSink& output,
+                         InputMode mode = InputMode::kBuffered,
+                         ProcessingStats* stats = nullptr);
+
+// Reading the same data from a memory mapped file. Lines are parsed in place,
+// without per-line allocations, and every event is handled right after it is
+// parsed, as in InputMode::kStreaming. Output goes to std::cout
+void ProcessingMappedInputData(const std::filesystem::path& file_path);
+
+// The same, output goes to the given sink. Phase times are added to the
+// stats if they are given
+void ProcessingMappedInputData(const std::filesystem::path& file_path,
+                               cybercafe_monitoring_system::OutputSink& output,
+                               ProcessingStats* stats = nullptr);
+
+// The same with a checkpoint of the whole state written to options.path every
+// options.interval_events events. If the checkpoint exists, the state is
+// restored from it and only the rest of the input is handled, the output of
+// the events since that checkpoint is printed again. The checkpoint holds the
+// size of the input and a checksum of the bytes it consumed, a checkpoint of
+// another input throws std::runtime_error. It is removed when the day is
+// closed and kept when the run fails, so a rerun after a crash, an output
+// error or a fix of the lines after it goes on from it
+void ProcessingMappedInputData(const std::filesystem::path& file_path,
+                               cybercafe_monitoring_system::OutputSink& output,
+                               const CheckpointOptions& options);
+
+// The same as ProcessingMappedInputData with the lines parsed and order-checked
+// on one thread, the events handled on the calling thread and the output
+// formatted and written on a third one, all overlapped. The output, errors
+// included, is the same. Phase times are added to the stats if they are given
+void ProcessingPipelinedInputData(
+    const std::filesystem::path& file_path,
+    cybercafe_monitoring_system::OutputSink& output,
+    ProcessingStats* stats = nullptr);
+
+// Reading the data from a memory mapped file with the event lines parsed in
+// chunks on threads_count threads (0 for one per hardware thread). Every line
+// is parsed and every event is checked against the one before it before the
+// first event is handled, as in InputMode::kBuffered: an incorrect line is
+// reported with nothing printed and an event earlier than the one before it
+// is printed alone. An event the system rejects while handling it is reported
+// as its line, where InputMode::kBuffered has no line left to report. Phase
+// times are added to the stats if they are given
+void ProcessingParallelInputData(
+    const std::filesystem::path& file_path,
+    cybercafe_monitoring_system::OutputSink& output, size_t threads_count = 0,
+    ProcessingStats* stats = nullptr);
+
+// Replaying a binary event log made by ConvertTextToBinaryLog. Blocks are
+// decoded straight into event records, no text is parsed, and events are
+// handled as in ProcessingMappedInputData. Phase times are added to the stats
+// if they are given
+void ProcessingBinaryInputData(const std::filesystem::path& file_path,
+                               cybercafe_monitoring_system::OutputSink& output,
+                               ProcessingStats* stats = nullptr);
+
+// Converts the text input format into a binary event log. Events are checked
+// like the processing does, except for their order, which is kept as is and
+// checked on replay. Throws std::runtime_error with the first incorrect line,
+// the log is left unfinished then
+void ConvertTextToBinaryLog(const std::filesystem::path& text_path,
+                            const std::filesystem::path& binary_path);
+
+// Converts a binary event log back into the text input format
+void ConvertBinaryToTextLog(const std::filesystem::path& binary_path,
+                            const std::filesystem::path& text_path);
+
+// Prints the state of the day at every time: the occupied tables with their
+// clients and the waiting queue. The events are handled once, keeping
+// periodic checkpoints, and every state is restored from the nearest one.
+// Throws std::runtime_error with the first incorrect line
+void ProcessingStateQueries(
+    const std::filesystem::path& file_path,
+    std::span<const cybercafe_monitoring_system::TimePoint> times,
+    cybercafe_monitoring_system::OutputSink& output);
+
+// Reads CybercafeMonitoringSystem constructor arguments (the first three
+// lines of the input file format) and serves terminals on the Unix-domain
+// socket until SIGINT or SIGTERM. Output goes to std::cout, the live stats go
+// to std::cerr at exit. Linux only
+void ProcessingLiveInputData(std::istream& config,
+                             const std::filesystem::path& socket_path);
 
 }  // namespace cybercafe_monitoring_system_test
 
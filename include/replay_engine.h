@@ -0,0 +1,74 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Queries of the cybercafe state at any time of a handled day
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_REPLAY_ENGINE_H_
+#define INCLUDE_REPLAY_ENGINE_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "include/binary_event_log.h"
+#include "include/cybercafe_monitoring_system.h"
+#include "include/output_sink.h"
+
+namespace cybercafe_monitoring_system {
+
+// Answers "who was sitting where at T" without handling the whole day again.
+// The events are handled once, keeping a checkpoint of the state every
+// interval_events events. A query restores the last checkpoint taken before
+// any event later than T and handles only the events after it, so it costs
+// at most interval_events events, whatever the day length
+class ReplayEngine final {
+ public:
+  static constexpr uint64_t kDefaultIntervalEvents = 4096;
+
+  // Handles the events text, the input without its first three lines, which
+  // must outlive the engine. Throws std::runtime_error with the first
+  // incorrect line, including an event earlier than the previous one
+  ReplayEngine(const EventLogHeader& header, std::string_view events,
+               uint64_t interval_events = kDefaultIntervalEvents);
+
+  // A system of the day configuration, for RestoreAt
+  CybercafeMonitoringSystem MakeSystem(OutputSink& output) const;
+
+  // Restores into the system the state after every event until the time, in
+  // minutes since midnight. At or after the closing time the day is closed
+  // too, so no one is left inside. The output of the events handled after the
+  // checkpoint and of the closing goes to the system sink. Returns the number
+  // of those events
+  uint64_t RestoreAt(int32_t minutes, CybercafeMonitoringSystem& system) const;
+
+  // Prints the time, every occupied table with its client and the waiting
+  // queue from the front
+  void PrintStateAt(int32_t minutes, OutputSink& output) const;
+
+  inline size_t GetCheckpointsCount() const { return checkpoints_.size(); }
+
+ private:
+  struct Checkpoint {
+    // Time of the last event before the checkpoint, -1 if there is none
+    int32_t minutes;
+
+    std::string data;
+  };
+
+  EventLogHeader header_;
+
+  std::string_view events_;
+
+  // In the events order, so in the time order too
+  std::vector<Checkpoint> checkpoints_;
+};
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_REPLAY_ENGINE_H_
@@ -0,0 +1,143 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Ledger of the table sessions of a day and their re-pricing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_SESSION_LEDGER_H_
+#define INCLUDE_SESSION_LEDGER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "include/client_name_interner.h"
+#include "include/table_stats_store.h"
+
+namespace cybercafe_monitoring_system {
+
+// Every finished session in the order it ended, one dense array per field.
+// Sessions come with the dense client ids of the caller, e.g. the system, and
+// every name is copied once into the ledger, so the ledger stays valid after
+// the caller forgets its clients
+class SessionLedger final {
+ public:
+  template <typename T>
+  using Column = std::vector<T, CacheAlignedAllocator<T>>;
+
+  // Appends a session of minutes [start, end) since midnight. The client id
+  // must name the same client until ForgetClientIds
+  inline void Append(ClientId client, std::string_view client_name,
+                     int32_t table_id, int32_t start, int32_t end,
+                     int64_t charge) {
+    if (client >= ledger_ids_.size())
+      ledger_ids_.resize(client + 1, kNoClient);
+    if (ledger_ids_[client] == kNoClient)
+      ledger_ids_[client] = AddClientName(client_name);
+
+    clients_.push_back(ledger_ids_[client]);
+    tables_.push_back(table_id);
+    starts_.push_back(start);
+    ends_.push_back(end);
+    charges_.push_back(charge);
+  }
+
+  // Called when the caller clears its client ids, the names are kept
+  inline void ForgetClientIds() { ledger_ids_.clear(); }
+
+  // Forgets the sessions and the names without releasing the arrays
+  void Clear();
+
+  inline size_t Size() const { return clients_.size(); }
+
+  inline std::string_view GetClientName(size_t session) const {
+    const ClientId client = clients_[session];
+    return std::string_view(names_).substr(
+        name_offsets_[client],
+        name_offsets_[client + 1] - name_offsets_[client]);
+  }
+
+  // Client ids of the ledger itself, numbered from 0 in the order the
+  // clients first ended a session
+  inline std::span<const ClientId> GetClients() const { return clients_; }
+
+  inline std::span<const int32_t> GetTables() const { return tables_; }
+
+  inline std::span<const int32_t> GetStarts() const { return starts_; }
+
+  inline std::span<const int32_t> GetEnds() const { return ends_; }
+
+  // What every session was charged when it ended
+  inline std::span<const int64_t> GetCharges() const { return charges_; }
+
+ private:
+  // Returns the ledger id of the copied name
+  ClientId AddClientName(std::string_view client_name);
+
+  // Ledger id of every caller id, kNoClient if not seen yet
+  std::vector<ClientId> ledger_ids_;
+
+  // Names one after another, the name of client i is
+  // names_[name_offsets_[i], name_offsets_[i + 1])
+  std::string names_;
+
+  std::vector<size_t> name_offsets_{0};
+
+  Column<ClientId> clients_;
+
+  Column<int32_t> tables_;
+
+  Column<int32_t> starts_;
+
+  Column<int32_t> ends_;
+
+  Column<int64_t> charges_;
+};
+
+// How a session is priced: every started billing period costs the rate, and
+// no session costs more than the cap
+struct TariffPlan {
+  int64_t rate = 0;
+
+  // 60 is the hourly billing of the system, 1 bills by the minute
+  int32_t billing_minutes = 60;
+
+  // 0 for no cap
+  int64_t session_cap = 0;
+};
+
+// Revenue of sessions under one tariff plan
+struct RevenueReport {
+  explicit RevenueReport(int tables_count)
+      : tables(static_cast<size_t>(tables_count)) {}
+
+  // By table id - 1
+  std::vector<int64_t> tables;
+
+  // By the hour the session started
+  std::array<int64_t, 24> hours{};
+
+  int64_t total = 0;
+};
+
+// Adds the revenue of the ledger sessions under every plan to the report of
+// the same index, so reports of many days add up. Every plan is turned into a
+// price for each session length first, then the sessions are priced in blocks
+// by one lookup each, without divisions or branches. Throws
+// std::invalid_argument if the counts differ, a plan is incorrect or a session
+// does not fit the reports
+void RepriceSessions(const SessionLedger& ledger,
+                     std::span<const TariffPlan> plans,
+                     std::span<RevenueReport> reports);
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_SESSION_LEDGER_H_
@@ -0,0 +1,77 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Bounded single producer single consumer queue
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_SPSC_QUEUE_H_
+#define INCLUDE_SPSC_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace cybercafe_monitoring_system {
+
+// Lock-free ring buffer for exactly one pushing and one popping thread. Slots
+// are allocated once. A full Push and an empty Pop block on the opposite
+// index with std::atomic::wait instead of spinning
+template <typename T>
+class SpscQueue final {
+ public:
+  // The capacity is rounded up to a power of two
+  explicit SpscQueue(size_t capacity)
+      : slots_(std::bit_ceil(std::max<size_t>(capacity, 2))),
+        mask_(slots_.size() - 1) {}
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  // Producer side
+  void Push(T value) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    for (size_t head; tail - (head = head_.load(std::memory_order_acquire)) ==
+                      slots_.size();)
+      head_.wait(head, std::memory_order_acquire);
+
+    slots_[tail & mask_] = std::move(value);
+    tail_.store(tail + 1, std::memory_order_release);
+    tail_.notify_one();
+  }
+
+  // Consumer side
+  T Pop() {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    for (size_t tail; (tail = tail_.load(std::memory_order_acquire)) == head;)
+      tail_.wait(tail, std::memory_order_acquire);
+
+    T value = std::move(slots_[head & mask_]);
+    head_.store(head + 1, std::memory_order_release);
+    head_.notify_one();
+    return value;
+  }
+
+  inline size_t Capacity() const { return slots_.size(); }
+
+ private:
+  std::vector<T> slots_;
+
+  size_t mask_;
+
+  // Next slot to pop, written by the consumer only
+  alignas(64) std::atomic<size_t> head_ = 0;
+
+  // Next slot to push, written by the producer only
+  alignas(64) std::atomic<size_t> tail_ = 0;
+};
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_SPSC_QUEUE_H_
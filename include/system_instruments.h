@@ -0,0 +1,176 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Optional counters and timers of the cybercafe monitoring system hot path
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_SYSTEM_INSTRUMENTS_H_
+#define INCLUDE_SYSTEM_INSTRUMENTS_H_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "include/latency_histogram.h"
+#include "include/output_sink.h"
+
+namespace cybercafe_monitoring_system {
+
+// Reasons of the k13 error events
+enum class ErrorReason {
+  kYouShallNotPass,
+  kNotOpenYet,
+  kPlaceIsBusy,
+  kClientUnknown,
+  kICanWaitNoLonger,
+  kYouAlreadyAtTable,
+};
+
+inline constexpr size_t kErrorReasonsCount = 6;
+
+// Text printed after the k13 event header
+inline constexpr std::string_view GetErrorReasonText(ErrorReason reason) {
+  constexpr std::array<std::string_view, kErrorReasonsCount> kTexts = {
+      "YouShallNotPass", "NotOpenYet",         "PlaceIsBusy",
+      "ClientUnknown",   "ICanWaitNoLonger!", "YouAlreadyAtTable!"};
+  return kTexts[static_cast<size_t>(reason)];
+}
+
+// Timed parts of the event handling
+enum class InstrumentedHandler {
+  kClientArrived,
+  kClientSatAtTable,
+  kClientWaiting,
+  kClientLeft,
+  kClientDeparture,
+};
+
+inline constexpr size_t kInstrumentedHandlersCount = 5;
+
+// Counters of the current day, kept after closing until the next opening
+struct InstrumentsSnapshot {
+  // Indexed by the event id value
+  std::array<uint64_t, 14> events{};
+
+  std::array<uint64_t, kErrorReasonsCount> errors{};
+
+  size_t max_waiting_clients = 0;
+
+  int max_occupied_tables = 0;
+
+  // A handler generating an event also pays for handling it
+  std::array<LatencyHistogram, kInstrumentedHandlersCount> handlers_latency{};
+};
+
+// Prints the counters and the p50/p99/max of every handler
+void PrintInstrumentsSnapshot(const InstrumentsSnapshot& snapshot,
+                              OutputSink& output);
+
+#ifdef CYBERCAFE_INSTRUMENTATION
+
+inline constexpr bool kInstrumentationEnabled = true;
+
+// Collects the counters. Built with CYBERCAFE_INSTRUMENTATION only, otherwise
+// every call is an empty inline function
+class SystemInstruments final {
+ public:
+  // Adds the time from construction to destruction to the handler histogram
+  class ScopedTimer final {
+   public:
+    ScopedTimer(SystemInstruments& instruments, InstrumentedHandler handler)
+        : histogram_(instruments.snapshot_.handlers_latency[static_cast<size_t>(
+              handler)]),
+          start_(std::chrono::steady_clock::now()) {}
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    ~ScopedTimer() {
+      histogram_.Record(std::chrono::steady_clock::now() - start_);
+    }
+
+   private:
+    LatencyHistogram& histogram_;
+
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  inline void CountEvent(int id) {
+    if (id >= 0 and id < static_cast<int>(snapshot_.events.size()))
+      ++snapshot_.events[id];
+  }
+
+  inline void CountError(ErrorReason reason) {
+    ++snapshot_.errors[static_cast<size_t>(reason)];
+  }
+
+  inline void ObserveWaitingClients(size_t count) {
+    snapshot_.max_waiting_clients =
+        std::max(snapshot_.max_waiting_clients, count);
+  }
+
+  inline void ObserveOccupiedTables(int count) {
+    snapshot_.max_occupied_tables =
+        std::max(snapshot_.max_occupied_tables, count);
+  }
+
+  inline ScopedTimer Time(InstrumentedHandler handler) {
+    return ScopedTimer(*this, handler);
+  }
+
+  inline InstrumentsSnapshot GetSnapshot() const { return snapshot_; }
+
+  inline void Reset() { snapshot_ = InstrumentsSnapshot{}; }
+
+  // The dump goes to std::cerr if no report sink is set
+  inline void SetReport(OutputSink* report) { report_ = report; }
+
+  // Prints the snapshot to the report sink
+  void Report() const;
+
+ private:
+  InstrumentsSnapshot snapshot_;
+
+  OutputSink* report_ = nullptr;
+};
+
+#else
+
+inline constexpr bool kInstrumentationEnabled = false;
+
+// Compiled out: every call is empty and the snapshot stays zero
+class SystemInstruments final {
+ public:
+  struct ScopedTimer final {};
+
+  inline void CountEvent(int) {}
+
+  inline void CountError(ErrorReason) {}
+
+  inline void ObserveWaitingClients(size_t) {}
+
+  inline void ObserveOccupiedTables(int) {}
+
+  inline ScopedTimer Time(InstrumentedHandler) { return ScopedTimer{}; }
+
+  inline InstrumentsSnapshot GetSnapshot() const { return {}; }
+
+  inline void Reset() {}
+
+  inline void SetReport(OutputSink*) {}
+
+  inline void Report() const {}
+};
+
+#endif
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_SYSTEM_INSTRUMENTS_H_
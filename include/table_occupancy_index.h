@@ -0,0 +1,91 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Dense index of occupied tables
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_TABLE_OCCUPANCY_INDEX_H_
+#define INCLUDE_TABLE_OCCUPANCY_INDEX_H_
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "include/client_name_interner.h"
+
+namespace cybercafe_monitoring_system {
+
+// Keeps one bit per table and the id of the client sitting at it. Tables are
+// numbered from 1, ids are expected to be checked by the caller
+class TableOccupancyIndex final {
+ public:
+  explicit TableOccupancyIndex(int tables_count);
+
+  inline bool IsOccupied(int table_id) const {
+    const auto bit = static_cast<size_t>(table_id - 1);
+    return (occupied_[bit / kBitsPerWord] >> (bit % kBitsPerWord)) & 1u;
+  }
+
+  inline void Occupy(int table_id, ClientId client) {
+    const auto bit = static_cast<size_t>(table_id - 1);
+    occupied_[bit / kBitsPerWord] |= uint64_t{1} << (bit % kBitsPerWord);
+    occupants_[bit] = client;
+    ++occupied_count_;
+  }
+
+  inline void Release(int table_id) {
+    const auto bit = static_cast<size_t>(table_id - 1);
+    occupied_[bit / kBitsPerWord] &= ~(uint64_t{1} << (bit % kBitsPerWord));
+    occupants_[bit] = kNoClient;
+    --occupied_count_;
+  }
+
+  // Returns the client sitting at the table or kNoClient if it is free
+  inline ClientId GetOccupant(int table_id) const {
+    return occupants_[static_cast<size_t>(table_id - 1)];
+  }
+
+  inline int GetOccupiedCount() const { return occupied_count_; }
+
+  // Returns the smallest free table id or 0 if all tables are occupied
+  int FindFirstFreeTable() const;
+
+  // Calls visit(table_id, client) for every occupied table in id order,
+  // skipping free tables a word at a time
+  template <typename Visitor>
+  void ForEachOccupied(Visitor&& visit) const {
+    for (size_t word = 0, word_end = occupied_.size(); word != word_end;
+         ++word)
+      for (uint64_t bits = occupied_[word]; bits != 0; bits &= bits - 1) {
+        const size_t bit = word * kBitsPerWord + std::countr_zero(bits);
+        visit(static_cast<int>(bit) + 1, occupants_[bit]);
+      }
+  }
+
+  // Frees every table
+  inline void ReleaseAll() {
+    std::ranges::fill(occupied_, 0);
+    std::ranges::fill(occupants_, kNoClient);
+    occupied_count_ = 0;
+  }
+
+ private:
+  static constexpr size_t kBitsPerWord = 64;
+
+  int tables_count_;
+
+  int occupied_count_ = 0;
+
+  std::vector<uint64_t> occupied_;
+
+  std::vector<ClientId> occupants_;
+};
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_TABLE_OCCUPANCY_INDEX_H_
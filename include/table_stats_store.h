@@ -0,0 +1,126 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Dense per-table daily statistics of the cybercafe monitoring system
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_TABLE_STATS_STORE_H_
+#define INCLUDE_TABLE_STATS_STORE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace cybercafe_monitoring_system {
+
+// Allocates arrays on cache line boundaries
+template <typename T>
+class CacheAlignedAllocator {
+ public:
+  using value_type = T;
+
+  static constexpr std::align_val_t kAlignment{64};
+
+  CacheAlignedAllocator() = default;
+
+  template <typename U>
+  CacheAlignedAllocator(const CacheAlignedAllocator<U>&) {}
+
+  inline T* allocate(size_t count) {
+    return static_cast<T*>(::operator new(count * sizeof(T), kAlignment));
+  }
+
+  inline void deallocate(T* data, size_t) {
+    ::operator delete(data, kAlignment);
+  }
+
+  template <typename U>
+  bool operator==(const CacheAlignedAllocator<U>&) const {
+    return true;
+  }
+};
+
+// Keeps the session start, the used minutes and the revenue of every table in
+// separate dense arrays. Tables are numbered from 1, ids are expected to be
+// checked by the caller. The arrays are allocated once and reused every day
+class TableStatsStore final {
+ public:
+  template <typename T>
+  using Array = std::vector<T, CacheAlignedAllocator<T>>;
+
+  explicit TableStatsStore(int tables_count);
+
+  // Zeroes the daily statistics without reallocating
+  void Reset();
+
+  // Remembers when the current session at the table began
+  inline void StartSession(int table_id, int32_t minutes) {
+    session_start_[Index(table_id)] = minutes;
+  }
+
+  // Adds the session time to the table usage and returns the session charge,
+  // every started hour is paid in full
+  inline int64_t EndSession(int table_id, int32_t minutes,
+                            int64_t hourly_rate) {
+    const size_t index = Index(table_id);
+    const int64_t duration = minutes - session_start_[index];
+    const int64_t charge = (duration + 59) / 60 * hourly_rate;
+
+    used_minutes_[index] += duration;
+    revenue_[index] += charge;
+    return charge;
+  }
+
+  // Start of the current or the last session at the table
+  inline int32_t GetSessionStart(int table_id) const {
+    return session_start_[Index(table_id)];
+  }
+
+  // Sets all statistics of the table, e.g. from a checkpoint
+  inline void Restore(int table_id, int32_t session_start,
+                      int64_t used_minutes, int64_t revenue) {
+    const size_t index = Index(table_id);
+    session_start_[index] = session_start;
+    used_minutes_[index] = used_minutes;
+    revenue_[index] = revenue;
+  }
+
+  inline int64_t GetUsedMinutes(int table_id) const {
+    return used_minutes_[Index(table_id)];
+  }
+
+  inline int64_t GetRevenue(int table_id) const {
+    return revenue_[Index(table_id)];
+  }
+
+  // Sum of the revenue of all tables
+  int64_t GetTotalRevenue() const;
+
+  // Sum of the used minutes of all tables
+  int64_t GetTotalUsedMinutes() const;
+
+  inline int GetTablesCount() const { return tables_count_; }
+
+ private:
+  inline static size_t Index(int table_id) {
+    return static_cast<size_t>(table_id - 1);
+  }
+
+  int tables_count_;
+
+  // Minutes since midnight
+  Array<int32_t> session_start_;
+
+  Array<int64_t> used_minutes_;
+
+  Array<int64_t> revenue_;
+};
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_TABLE_STATS_STORE_H_
@@ -0,0 +1,222 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Many cybercafe venues hosted in one process
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_VENUE_ENGINE_H_
+#define INCLUDE_VENUE_ENGINE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "include/cybercafe_monitoring_system.h"
+#include "include/output_sink.h"
+#include "include/spsc_queue.h"
+
+namespace cybercafe_monitoring_system {
+
+using VenueId = uint32_t;
+
+struct VenueConfig {
+  TimePoint opening_time;
+
+  TimePoint closing_time;
+
+  int tables_count = 0;
+
+  int hourly_rate = 0;
+};
+
+// Results of one venue over all closed days
+struct VenueTotals {
+  int64_t revenue = 0;
+
+  int64_t used_minutes = 0;
+
+  uint64_t handled_events = 0;
+
+  // Events with an incorrect client name, id or table, or out of time order.
+  // They are not printed
+  uint64_t rejected_events = 0;
+
+  // Handling the venue threw something other than an incorrect event, e.g. a
+  // write error of its output. Its later messages are dropped
+  bool failed = false;
+};
+
+// Sum of the totals of all venues
+struct ChainTotals {
+  int64_t revenue = 0;
+
+  int64_t used_minutes = 0;
+
+  uint64_t handled_events = 0;
+
+  uint64_t rejected_events = 0;
+
+  size_t venues_count = 0;
+
+  size_t failed_venues_count = 0;
+};
+
+// Hosts many venues, each with its own CybercafeMonitoringSystem. Venues are
+// spread over shards, every shard is a worker thread pinned to a core that
+// owns its venues exclusively and gets their events through its own lock-free
+// queue, so venues never share state or locks.
+//
+// Venues are added before Start. Routing calls (OpenDay, Submit, CloseDay,
+// Drain and the totals) are made from one thread
+class VenueEngine final {
+ public:
+  static constexpr size_t kDefaultQueueCapacity = size_t{1} << 12;
+
+  // 0 shards means one per hardware thread
+  explicit VenueEngine(size_t shards_count = 0,
+                       size_t queue_capacity = kDefaultQueueCapacity);
+
+  VenueEngine(const VenueEngine&) = delete;
+  VenueEngine& operator=(const VenueEngine&) = delete;
+
+  // Stops the workers after the queued events are handled
+  ~VenueEngine();
+
+  // The output sink must outlive the engine. Throws std::invalid_argument if
+  // the venue is already added or the engine is running
+  void AddVenue(VenueId venue_id, const VenueConfig& config,
+                OutputSink& output);
+
+  // Starts the shard workers
+  void Start();
+
+  // Handles the queued events and stops the shard workers
+  void Stop();
+
+  void OpenDay(VenueId venue_id);
+
+  // Queues an incoming event of the venue. Throws std::invalid_argument if
+  // the venue is unknown, event errors are counted in rejected_events
+  void Submit(VenueId venue_id, const TimePoint& time,
+              CybercafeMonitoringSystem::Event::Id id,
+              std::string_view client_name, int table_id = 0);
+
+  void CloseDay(VenueId venue_id);
+
+  // Waits until every queued message is handled
+  void Drain();
+
+  // Drains the queues and returns the venue results
+  VenueTotals GetVenueTotals(VenueId venue_id);
+
+  // Drains the queues and sums the results of all venues
+  ChainTotals GetChainTotals();
+
+  inline size_t GetShardsCount() const { return shards_.size(); }
+
+ private:
+  struct Venue {
+    Venue(VenueId venue_id, const VenueConfig& config, OutputSink& output)
+        : id(venue_id),
+          system(config.opening_time, config.closing_time,
+                 config.tables_count, config.hourly_rate, output) {}
+
+    VenueId id;
+
+    CybercafeMonitoringSystem system;
+
+    // Minutes of the last handled event of the day
+    std::optional<int32_t> previous_minutes;
+
+    VenueTotals totals;
+  };
+
+  struct Message {
+    enum class Kind {
+      kOpenDay,
+      kEvent,
+      kCloseDay,
+      kStop,
+    };
+
+    explicit Message(Kind message_kind = Kind::kStop,
+                     const TimePoint& event_time = TimePoint{},
+                     CybercafeMonitoringSystem::Event::Id event_id =
+                         CybercafeMonitoringSystem::Event::Id::kBadId,
+                     std::string_view event_client_name = {},
+                     int event_table_id = 0)
+        : kind(message_kind),
+          time(event_time),
+          id(event_id),
+          table_id(event_table_id),
+          client_name(event_client_name) {}
+
+    Kind kind;
+
+    // Set by the router
+    Venue* venue = nullptr;
+
+    TimePoint time;
+
+    CybercafeMonitoringSystem::Event::Id id;
+
+    int table_id;
+
+    std::string client_name;
+  };
+
+  struct Shard {
+    explicit Shard(size_t queue_capacity) : queue(queue_capacity) {}
+
+    // Handles messages until kStop
+    void Run();
+
+    // Handles one message on the worker thread. An error fails only the
+    // venue of the message
+    void Handle(Message& message);
+
+    // Handles one event, an incorrect one is rejected before it is printed
+    static void HandleEvent(Venue& venue, const Message& message);
+
+    SpscQueue<Message> queue;
+
+    std::vector<std::unique_ptr<Venue>> venues;
+
+    // Messages pushed by the routing thread
+    uint64_t submitted = 0;
+
+    // Messages handled by the worker
+    alignas(64) std::atomic<uint64_t> handled = 0;
+
+    std::jthread worker;
+  };
+
+  // Routes the message to the shard of the venue
+  void Route(VenueId venue_id, Message message);
+
+  // Throws std::invalid_argument if the venue is unknown
+  const std::pair<Venue*, size_t>& FindRoute(VenueId venue_id) const;
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  // Venue id to its venue and shard index
+  std::unordered_map<VenueId, std::pair<Venue*, size_t>> routes_;
+
+  bool running_ = false;
+};
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_VENUE_ENGINE_H_
@@ -0,0 +1,107 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Queue of clients waiting for a free table
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_WAITING_QUEUE_H_
+#define INCLUDE_WAITING_QUEUE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "include/client_name_interner.h"
+
+namespace cybercafe_monitoring_system {
+
+// FIFO of client ids as a doubly linked list threaded through a slot array
+// indexed by the client id itself. Push, pop and removal of any client are
+// O(1), and a client is queued at most once
+class WaitingQueue final {
+ public:
+  inline bool Contains(ClientId client) const {
+    return client < links_.size() and links_[client].queued;
+  }
+
+  inline bool Empty() const { return size_ == 0; }
+
+  inline size_t Size() const { return size_; }
+
+  inline ClientId Front() const { return head_; }
+
+  // Appends the client. Returns false if it is already queued
+  inline bool PushBack(ClientId client) {
+    if (client >= links_.size()) links_.resize(client + 1);
+    if (links_[client].queued) return false;
+
+    links_[client] = Link{tail_, kNoClient, true};
+    if (tail_ == kNoClient)
+      head_ = client;
+    else
+      links_[tail_].next = client;
+    tail_ = client;
+    ++size_;
+
+    return true;
+  }
+
+  inline void PopFront() { Remove(head_); }
+
+  // Unlinks the client if it is queued
+  inline void Remove(ClientId client) {
+    if (not Contains(client)) return;
+
+    Link& link = links_[client];
+    if (link.prev == kNoClient)
+      head_ = link.next;
+    else
+      links_[link.prev].next = link.next;
+
+    if (link.next == kNoClient)
+      tail_ = link.prev;
+    else
+      links_[link.next].prev = link.prev;
+
+    link = Link{};
+    --size_;
+  }
+
+  // Visits queued clients from the front
+  template <typename Visitor>
+  void ForEach(Visitor&& visitor) const {
+    for (ClientId client = head_; client != kNoClient;
+         client = links_[client].next)
+      visitor(client);
+  }
+
+  inline void Clear() {
+    links_.clear();
+    head_ = tail_ = kNoClient;
+    size_ = 0;
+  }
+
+ private:
+  struct Link {
+    ClientId prev = kNoClient;
+
+    ClientId next = kNoClient;
+
+    bool queued = false;
+  };
+
+  std::vector<Link> links_;
+
+  ClientId head_ = kNoClient;
+
+  ClientId tail_ = kNoClient;
+
+  size_t size_ = 0;
+};
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_WAITING_QUEUE_H_
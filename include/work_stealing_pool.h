@@ -0,0 +1,41 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Work stealing thread pool for independent tasks
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef INCLUDE_WORK_STEALING_POOL_H_
+#define INCLUDE_WORK_STEALING_POOL_H_
+
+#include <cstddef>
+#include <functional>
+
+namespace cybercafe_monitoring_system {
+
+// Runs a known set of independent tasks on several threads. Every worker has
+// its own queue of task indices and, when it runs dry, steals from the back
+// of the others, so a few long tasks do not leave the rest of the workers idle
+class WorkStealingPool final {
+ public:
+  // 0 threads means one per hardware thread
+  explicit WorkStealingPool(size_t threads_count = 0);
+
+  // Calls task(i) for every i in [0, tasks_count) and returns when all calls
+  // are done. The first exception thrown by a task is rethrown here, the
+  // remaining tasks are still run
+  void ForEach(size_t tasks_count,
+               const std::function<void(size_t)>& task) const;
+
+  inline size_t GetThreadsCount() const { return threads_count_; }
+
+ private:
+  size_t threads_count_;
+};
+
+}  // namespace cybercafe_monitoring_system
+
+#endif  // INCLUDE_WORK_STEALING_POOL_H_
@@ -0,0 +1,214 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Processing many day logs at once
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/batch_runner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <map>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "include/output_sink.h"
+#include "include/read_input_data.h"
+#include "include/work_stealing_pool.h"
+
+namespace {
+
+using cybercafe_monitoring_system::OutputSink;
+using cybercafe_monitoring_system_test::BatchFileResult;
+using cybercafe_monitoring_system_test::BatchOptions;
+
+using Clock = std::chrono::steady_clock;
+
+// Regular files of the directory in name order
+void AppendDirectoryFiles(const std::filesystem::path& directory,
+                          std::vector<std::filesystem::path>& inputs) {
+  std::vector<std::filesystem::path> files;
+  for (const auto& entry : std::filesystem::directory_iterator(directory))
+    if (entry.is_regular_file()) files.push_back(entry.path());
+
+  std::ranges::sort(files);
+  inputs.insert(inputs.end(), files.begin(), files.end());
+}
+
+// Paths listed in the manifest, one per line
+void AppendManifestFiles(const std::filesystem::path& manifest,
+                         std::vector<std::filesystem::path>& inputs) {
+  std::ifstream file(manifest);
+  if (!file.is_open())
+    throw std::runtime_error(
+        std::format("Cannot open manifest: {}", manifest.string()));
+
+  std::string file_line;
+  while (std::getline(file, file_line)) {
+    if (not file_line.empty() and file_line.back() == '\r')
+      file_line.pop_back();
+    if (file_line.empty()) continue;
+
+    std::filesystem::path input(file_line);
+    inputs.push_back(input.is_absolute() ? input
+                                         : manifest.parent_path() / input);
+  }
+}
+
+// <output_dir>/<input filename>.out with a numeric suffix for repeated names
+std::vector<std::filesystem::path> MakeOutputPaths(
+    std::span<const std::filesystem::path> inputs,
+    const std::filesystem::path& output_dir) {
+  std::map<std::filesystem::path, int> name_uses;
+  std::vector<std::filesystem::path> outputs;
+  outputs.reserve(inputs.size());
+
+  for (const auto& input : inputs) {
+    const std::filesystem::path name = input.filename();
+    const int uses = name_uses[name]++;
+    outputs.push_back(
+        output_dir /
+        (uses == 0 ? std::format("{}.out", name.string())
+                   : std::format("{}.{}.out", name.string(), uses)));
+  }
+
+  return outputs;
+}
+
+// Processes one input, errors are recorded instead of being thrown
+void ProcessBatchFile(const BatchOptions& options, BatchFileResult& result) {
+  const auto start = Clock::now();
+
+  try {
+    result.input_bytes = std::filesystem::is_regular_file(result.input_path)
+                             ? std::filesystem::file_size(result.input_path)
+                             : 0;
+
+    cybercafe_monitoring_system::FileOutputSink output(result.output_path);
+
+    if (options.use_mapped_reader and
+        std::filesystem::is_regular_file(result.input_path)) {
+      cybercafe_monitoring_system_test::ProcessingMappedInputData(
+          result.input_path, output);
+    } else {
+      std::ifstream file(result.input_path);
+      if (!file.is_open())
+        throw std::runtime_error(
+            std::format("Cannot open file: {}", result.input_path.string()));
+
+      cybercafe_monitoring_system_test::ProcessingInputData(file, output,
+                                                            options.mode);
+    }
+
+    output.Close();
+  } catch (const std::exception& e) {
+    result.error = e.what();
+    if (result.error.empty()) result.error = "Unknown error";
+  }
+
+  result.elapsed = Clock::now() - start;
+}
+
+// Prints "<bytes> bytes <ms> ms <MiB/s> MiB/s"
+void PrintThroughput(OutputSink& output, uintmax_t bytes,
+                     std::chrono::nanoseconds elapsed) {
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  const double mebibytes = static_cast<double>(bytes) / (1 << 20);
+
+  output.Print("{} bytes {:.3f} ms {:.2f} MiB/s", bytes, seconds * 1000,
+               seconds > 0 ? mebibytes / seconds : 0.0);
+}
+
+}  // namespace
+
+namespace cybercafe_monitoring_system_test {
+
+size_t BatchResult::GetFailedCount() const {
+  return static_cast<size_t>(std::ranges::count_if(
+      files, [](const BatchFileResult& file) { return !file.error.empty(); }));
+}
+
+// Expands the arguments into input files
+std::vector<std::filesystem::path> CollectBatchInputs(
+    std::span<const std::string_view> arguments) {
+  std::vector<std::filesystem::path> inputs;
+
+  for (std::string_view argument : arguments) {
+    if (argument.starts_with('@')) {
+      AppendManifestFiles(argument.substr(1), inputs);
+    } else if (std::filesystem::is_directory(argument)) {
+      AppendDirectoryFiles(argument, inputs);
+    } else {
+      inputs.emplace_back(argument);
+    }
+  }
+
+  return inputs;
+}
+
+// Runs every input through its own CybercafeMonitoringSystem on a work
+// stealing pool
+BatchResult RunBatch(std::span<const std::filesystem::path> inputs,
+                     const BatchOptions& options) {
+  std::filesystem::create_directories(options.output_dir);
+
+  const cybercafe_monitoring_system::WorkStealingPool pool(
+      options.threads_count);
+
+  BatchResult result;
+  result.threads_count = pool.GetThreadsCount();
+  result.files.resize(inputs.size());
+
+  std::vector<std::filesystem::path> outputs =
+      MakeOutputPaths(inputs, options.output_dir);
+  for (size_t i = 0, iend = inputs.size(); i != iend; ++i) {
+    result.files[i].input_path = inputs[i];
+    result.files[i].output_path = std::move(outputs[i]);
+  }
+
+  const auto start = Clock::now();
+
+  // Every task owns its result slot, so no locking is needed
+  pool.ForEach(inputs.size(), [&](size_t i) {
+    ProcessBatchFile(options, result.files[i]);
+  });
+
+  result.elapsed = Clock::now() - start;
+
+  return result;
+}
+
+// Prints the throughput of every input and of the whole run
+void PrintBatchSummary(const BatchResult& result, OutputSink& output) {
+  uintmax_t total_bytes = 0;
+
+  for (const auto& file : result.files) {
+    total_bytes += file.input_bytes;
+
+    output.Print("{} ", file.input_path.string());
+    PrintThroughput(output, file.input_bytes, file.elapsed);
+    if (file.error.empty())
+      output.Write(" ok\n");
+    else
+      output.Print(" error: {}\n", file.error);
+  }
+
+  output.Print("total: {} files {} failed {} threads ", result.files.size(),
+               result.GetFailedCount(), result.threads_count);
+  PrintThroughput(output, total_bytes, result.elapsed);
+  output.Put('\n');
+  output.Flush();
+}
+
+}  // namespace cybercafe_monitoring_system_test
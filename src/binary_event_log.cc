@@ -0,0 +1,308 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Compact binary form of the event log
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/binary_event_log.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "include/client_name_interner.h"
+#include "include/client_name_validator.h"
+#include "include/cybercafe_monitoring_system.h"
+
+namespace {
+
+using Id = cybercafe_monitoring_system::CybercafeMonitoringSystem::Event::Id;
+
+constexpr std::string_view kMagic = "CYBEVLOG";
+
+// Magic, version, opening and closing time, tables count and hourly rate
+constexpr size_t kHeaderSize = 8 + 4 + 4 * 4;
+
+// Events count, packed size and checksum
+constexpr size_t kBlockHeaderSize = 4 + 4 + 8;
+
+// Offset of the dictionary at the very end of the log
+constexpr size_t kTrailerSize = 8;
+
+// The tag byte keeps the id in the low 2 bits and the time step since the
+// previous event of the block in the high 6 bits. A longer or a negative step
+// is escaped and follows as a varint
+constexpr uint8_t kEscapeStep = 63;
+
+constexpr int32_t kMinutesPerDay = 24 * 60;
+
+[[noreturn]] void ThrowCorrupt(std::string_view what) {
+  throw std::runtime_error(std::format("Corrupt event log: {}", what));
+}
+
+// Mixes 8 bytes per step, so checking a block costs about as much as reading
+// it. Enough to tell a torn or damaged file
+uint64_t Checksum(std::string_view data) {
+  uint64_t hash = 0xcbf29ce484222325 ^ data.size();
+  size_t i = 0;
+  for (; i + 8 <= data.size(); i += 8) {
+    uint64_t word;
+    std::memcpy(&word, data.data() + i, 8);
+    hash = (hash ^ word) * 0x9e3779b97f4a7c15;
+    hash ^= hash >> 32;
+  }
+  for (; i != data.size(); ++i)
+    hash = (hash ^ static_cast<uint8_t>(data[i])) * 0x100000001b3;
+  return hash;
+}
+
+template <typename T>
+void PutFixed(std::string& data, T value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  data.append(bytes, sizeof(T));
+}
+
+template <typename T>
+T GetFixed(std::string_view data, size_t offset) {
+  T value;
+  std::memcpy(&value, data.data() + offset, sizeof(T));
+  return value;
+}
+
+void PutVarint(std::string& data, uint64_t value) {
+  for (; value >= 0x80; value >>= 7)
+    data.push_back(static_cast<char>(value | 0x80));
+  data.push_back(static_cast<char>(value));
+}
+
+uint64_t GetVarint(const uint8_t*& data, const uint8_t* end) {
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (data == end) ThrowCorrupt("unexpected end");
+    const uint8_t byte = *data++;
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (byte < 0x80) return value;
+  }
+  ThrowCorrupt("bad varint");
+}
+
+// Small negative numbers become small varints
+inline uint64_t ZigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t UnZigZag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+bool IsMinutesValid(int64_t minutes) {
+  return minutes >= 0 and minutes < kMinutesPerDay;
+}
+
+}  // namespace
+
+namespace cybercafe_monitoring_system {
+
+// Creates the file and writes the header. Throws std::runtime_error if the
+// file cannot be created
+BinaryEventLogWriter::BinaryEventLogWriter(const std::filesystem::path& path,
+                                           const EventLogHeader& header)
+    : file_(std::fopen(path.string().c_str(), "wb")) {
+  if (file_ == nullptr)
+    throw std::runtime_error(
+        std::format("Cannot open file: {}", path.string()));
+
+  std::string data(kMagic);
+  PutFixed(data, kBinaryEventLogVersion);
+  PutFixed(data, header.opening_minutes);
+  PutFixed(data, header.closing_minutes);
+  PutFixed(data, header.tables_count);
+  PutFixed(data, header.hourly_rate);
+  WriteBytes(data);
+}
+
+// A log that was not finished stays incomplete and is rejected on reading
+BinaryEventLogWriter::~BinaryEventLogWriter() {
+  if (file_ != nullptr) std::fclose(file_);
+}
+
+// The id must be an incoming one, the name a valid client name and the table
+// id, for k2, within the tables count
+void BinaryEventLogWriter::Append(int32_t minutes,
+                                  CybercafeMonitoringSystem::Event::Id id,
+                                  std::string_view client_name,
+                                  int32_t table_id) {
+  const int64_t step = int64_t{minutes} - previous_minutes_;
+  const auto id_bits = static_cast<uint8_t>(static_cast<int>(id) - 1);
+  if (step >= 0 and step < kEscapeStep) {
+    block_.push_back(static_cast<char>(step << 2 | id_bits));
+  } else {
+    block_.push_back(static_cast<char>(kEscapeStep << 2 | id_bits));
+    PutVarint(block_, ZigZag(step));
+  }
+  previous_minutes_ = minutes;
+
+  PutVarint(block_, client_names_.Intern(client_name));
+  if (id == Id::k2) PutVarint(block_, ZigZag(table_id));
+
+  if (++block_events_ == kBlockEvents) FlushBlock();
+}
+
+// Writes the last block, the dictionary and its offset, then closes the file
+void BinaryEventLogWriter::Finish() {
+  if (block_events_ != 0) FlushBlock();
+
+  const uint64_t dictionary_offset = offset_;
+  std::string dictionary;
+  PutFixed(dictionary, static_cast<uint32_t>(client_names_.Size()));
+  for (ClientId client = 0; client != client_names_.Size(); ++client) {
+    std::string_view name = client_names_.GetName(client);
+    PutVarint(dictionary, name.size());
+    dictionary.append(name);
+  }
+  PutFixed(dictionary, Checksum(dictionary));
+  PutFixed(dictionary, dictionary_offset);
+  WriteBytes(dictionary);
+
+  const bool closed = std::fclose(file_) == 0;
+  file_ = nullptr;
+  if (not closed) throw std::runtime_error("Cannot write event log");
+}
+
+void BinaryEventLogWriter::FlushBlock() {
+  std::string header;
+  PutFixed(header, block_events_);
+  PutFixed(header, static_cast<uint32_t>(block_.size()));
+  PutFixed(header, Checksum(block_));
+  WriteBytes(header);
+  WriteBytes(block_);
+
+  block_.clear();
+  block_events_ = 0;
+  previous_minutes_ = 0;
+}
+
+void BinaryEventLogWriter::WriteBytes(std::string_view bytes) {
+  if (std::fwrite(bytes.data(), 1, bytes.size(), file_) != bytes.size())
+    throw std::runtime_error("Cannot write event log");
+  offset_ += bytes.size();
+}
+
+// Checks the header and the dictionary. Throws std::runtime_error if the data
+// is not a complete log of this version
+BinaryEventLogReader::BinaryEventLogReader(std::string_view data) {
+  if (data.size() < kHeaderSize + kTrailerSize or not data.starts_with(kMagic))
+    ThrowCorrupt("not an event log");
+  if (GetFixed<uint32_t>(data, kMagic.size()) != kBinaryEventLogVersion)
+    throw std::runtime_error("Unsupported event log version");
+
+  header_.opening_minutes = GetFixed<int32_t>(data, 12);
+  header_.closing_minutes = GetFixed<int32_t>(data, 16);
+  header_.tables_count = GetFixed<int32_t>(data, 20);
+  header_.hourly_rate = GetFixed<int32_t>(data, 24);
+  if (not IsMinutesValid(header_.opening_minutes) or
+      not IsMinutesValid(header_.closing_minutes) or
+      header_.tables_count <= 0 or header_.hourly_rate <= 0)
+    ThrowCorrupt("bad header");
+
+  const auto dictionary_offset =
+      GetFixed<uint64_t>(data, data.size() - kTrailerSize);
+  if (dictionary_offset < kHeaderSize or
+      dictionary_offset > data.size() - kTrailerSize - 8 - 4)
+    ThrowCorrupt("bad dictionary offset");
+
+  // The dictionary without its checksum
+  const std::string_view dictionary = data.substr(
+      dictionary_offset, data.size() - kTrailerSize - 8 - dictionary_offset);
+  if (Checksum(dictionary) !=
+      GetFixed<uint64_t>(data, data.size() - kTrailerSize - 8))
+    ThrowCorrupt("bad dictionary checksum");
+
+  const auto* names = reinterpret_cast<const uint8_t*>(dictionary.data());
+  const auto* names_end = names + dictionary.size();
+  const auto count = GetFixed<uint32_t>(dictionary, 0);
+  if (count > dictionary.size()) ThrowCorrupt("bad dictionary size");
+  names += 4;
+  client_names_.reserve(count);
+  for (uint32_t i = 0; i != count; ++i) {
+    const uint64_t size = GetVarint(names, names_end);
+    if (size > static_cast<uint64_t>(names_end - names))
+      ThrowCorrupt("unexpected end");
+
+    std::string_view name(reinterpret_cast<const char*>(names), size);
+    if (not IsClientNameValid(name)) ThrowCorrupt("bad client name");
+    client_names_.push_back(name);
+    names += size;
+  }
+  if (names != names_end) ThrowCorrupt("trailing dictionary data");
+
+  blocks_ = data.substr(kHeaderSize, dictionary_offset - kHeaderSize);
+}
+
+// Decodes the next block into events, replacing their contents. Returns false
+// after the last block
+bool BinaryEventLogReader::NextBlock(
+    std::span<const ClientId> clients,
+    std::vector<CybercafeMonitoringSystem::EventRecord>& events) {
+  if (blocks_.empty()) return false;
+  if (blocks_.size() < kBlockHeaderSize) ThrowCorrupt("unexpected end");
+
+  const auto count = GetFixed<uint32_t>(blocks_, 0);
+  const auto size = GetFixed<uint32_t>(blocks_, 4);
+  if (size > blocks_.size() - kBlockHeaderSize or count > size)
+    ThrowCorrupt("bad block size");
+
+  const std::string_view block = blocks_.substr(kBlockHeaderSize, size);
+  if (Checksum(block) != GetFixed<uint64_t>(blocks_, 8))
+    ThrowCorrupt("bad block checksum");
+  blocks_.remove_prefix(kBlockHeaderSize + size);
+
+  const auto* packed = reinterpret_cast<const uint8_t*>(block.data());
+  const auto* packed_end = packed + block.size();
+  int64_t minutes = 0;
+  events.resize(count);
+  for (auto& event : events) {
+    if (packed == packed_end) ThrowCorrupt("unexpected end");
+    const uint8_t tag = *packed++;
+
+    int64_t step = tag >> 2;
+    if (step == kEscapeStep) step = UnZigZag(GetVarint(packed, packed_end));
+    if (step <= -kMinutesPerDay or step >= kMinutesPerDay or
+        not IsMinutesValid(minutes += step))
+      ThrowCorrupt("bad time");
+
+    const auto id = static_cast<Id>((tag & 3) + 1);
+    const uint64_t client = GetVarint(packed, packed_end);
+    if (client >= clients.size()) ThrowCorrupt("bad client");
+
+    int64_t table_id = 0;
+    if (id == Id::k2) {
+      table_id = UnZigZag(GetVarint(packed, packed_end));
+      if (table_id < 1 or table_id > header_.tables_count)
+        ThrowCorrupt("bad table");
+    }
+
+    event = {static_cast<int32_t>(minutes), id, clients[client],
+             static_cast<int32_t>(table_id)};
+  }
+  if (packed != packed_end) ThrowCorrupt("trailing block data");
+
+  return true;
+}
+
+}  // namespace cybercafe_monitoring_system
@@ -0,0 +1,370 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Crash-safe snapshots of the cybercafe monitoring system state
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/checkpoint.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "include/client_name_interner.h"
+#include "include/client_name_validator.h"
+#include "include/mapped_file.h"
+#include "include/occupancy_timeline.h"
+#include "include/table_occupancy_index.h"
+#include "include/waiting_queue.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::string_view kMagic = "CYBCAFE\x01";
+
+// Magic, version, payload size and payload checksum
+constexpr size_t kHeaderSize = 8 + 4 + 8 + 8;
+
+[[noreturn]] void ThrowCorrupt(std::string_view what) {
+  throw std::runtime_error(std::format("Corrupt checkpoint: {}", what));
+}
+
+// Appends integers as raw bytes
+class Writer final {
+ public:
+  explicit Writer(std::string& data) : data_(data) {}
+
+  template <typename T>
+  void Put(T value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    data_.append(bytes, sizeof(T));
+  }
+
+  void PutBytes(std::string_view bytes) {
+    Put(static_cast<uint32_t>(bytes.size()));
+    data_.append(bytes);
+  }
+
+ private:
+  std::string& data_;
+};
+
+// Reads what Writer wrote, throwing when the data ends too early
+class Reader final {
+ public:
+  explicit Reader(std::string_view data) : data_(data) {}
+
+  template <typename T>
+  T Get() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (data_.size() < sizeof(T)) ThrowCorrupt("unexpected end");
+
+    T value;
+    std::memcpy(&value, data_.data(), sizeof(T));
+    data_.remove_prefix(sizeof(T));
+    return value;
+  }
+
+  std::string_view GetBytes() {
+    const auto size = Get<uint32_t>();
+    if (data_.size() < size) ThrowCorrupt("unexpected end");
+
+    std::string_view bytes = data_.substr(0, size);
+    data_.remove_prefix(size);
+    return bytes;
+  }
+
+  // Checks that a count of items of the given size fits into the rest
+  uint32_t GetCount(size_t item_size) {
+    const auto count = Get<uint32_t>();
+    if (count > data_.size() / item_size) ThrowCorrupt("bad count");
+    return count;
+  }
+
+  inline bool Empty() const { return data_.empty(); }
+
+ private:
+  std::string_view data_;
+};
+
+int32_t ToMinutes(const cybercafe_monitoring_system::TimePoint& time) {
+  return static_cast<int32_t>(time.time_since_epoch().count());
+}
+
+// Publishes the file contents before the rename makes them visible
+bool SyncFile(std::FILE* file) {
+  if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+  return _commit(_fileno(file)) == 0;
+#else
+  return ::fsync(::fileno(file)) == 0;
+#endif
+}
+
+// Makes the rename itself durable
+void SyncDirectory([[maybe_unused]] const std::filesystem::path& directory) {
+#ifndef _WIN32
+  const int fd = ::open(directory.empty() ? "." : directory.c_str(),
+                        O_RDONLY | O_DIRECTORY);
+  if (fd < 0) return;
+  ::fsync(fd);
+  ::close(fd);
+#endif
+}
+
+}  // namespace
+
+namespace cybercafe_monitoring_system {
+
+// FNV-1a of the bytes, continuing the checksum of the bytes before them.
+// Also enough to tell a torn or damaged checkpoint
+uint64_t ChecksumInput(std::string_view bytes, uint64_t checksum) {
+  for (char c : bytes) {
+    checksum ^= static_cast<uint8_t>(c);
+    checksum *= 0x100000001b3;
+  }
+  return checksum;
+}
+
+void CheckpointCodec::Encode(const CybercafeMonitoringSystem& system,
+                             const CheckpointPosition& position,
+                             std::string& data) {
+  std::string payload;
+  Writer writer(payload);
+
+  writer.Put(ToMinutes(system.opening_time_));
+  writer.Put(ToMinutes(system.closing_time_));
+  writer.Put(static_cast<int32_t>(system.tables_count_));
+  writer.Put(static_cast<int32_t>(system.hourly_rate_));
+
+  writer.Put(position.input_offset);
+  writer.Put(position.events);
+  writer.Put(static_cast<uint8_t>(position.last_event_minutes.has_value()));
+  writer.Put(position.last_event_minutes.value_or(0));
+  writer.Put(position.input_size);
+  writer.Put(position.input_checksum);
+
+  writer.Put(system.total_revenue_);
+
+  // A client who left is in the same state as one never seen, so only the
+  // clients inside are kept, renumbered in id order. The checkpoint size then
+  // depends on the tables and the queue, not on the clients of the day
+  std::vector<ClientId> kept_ids(system.clients_.size(), kNoClient);
+  ClientId kept_count = 0;
+  for (ClientId client = 0; client != system.clients_.size(); ++client)
+    if (system.clients_[client].inside) kept_ids[client] = kept_count++;
+
+  writer.Put(kept_count);
+  for (ClientId client = 0; client != system.clients_.size(); ++client) {
+    if (kept_ids[client] == kNoClient) continue;
+    writer.PutBytes(system.client_names_.GetName(client));
+    writer.Put(static_cast<int32_t>(system.clients_[client].table_id));
+    writer.Put(static_cast<uint8_t>(system.clients_[client].inside));
+  }
+
+  writer.Put(static_cast<uint32_t>(system.waiting_clients_.Size()));
+  system.waiting_clients_.ForEach(
+      [&writer, &kept_ids](ClientId client) { writer.Put(kept_ids[client]); });
+
+  for (int table_id = 1; table_id <= system.tables_count_; ++table_id) {
+    writer.Put(system.tables_stats_.GetSessionStart(table_id));
+    writer.Put(system.tables_stats_.GetUsedMinutes(table_id));
+    writer.Put(system.tables_stats_.GetRevenue(table_id));
+  }
+
+  const OccupancyTimeline& timeline = system.occupancy_timeline_;
+  for (const MinuteSeries* series :
+       {&timeline.GetOccupiedTables(), &timeline.GetWaitingClients()}) {
+    uint32_t changes_count = 0;
+    series->ForEachChange([&](int32_t, int32_t) { ++changes_count; });
+    writer.Put(changes_count);
+    series->ForEachChange([&writer](int32_t minute, int32_t delta) {
+      writer.Put(minute);
+      writer.Put(delta);
+    });
+  }
+
+  data.clear();
+  data.reserve(kHeaderSize + payload.size());
+  data.append(kMagic);
+  Writer header(data);
+  header.Put(kCheckpointVersion);
+  header.Put(static_cast<uint64_t>(payload.size()));
+  header.Put(ChecksumInput(payload));
+  data.append(payload);
+}
+
+// Throws std::runtime_error if the data is damaged, of another version or of
+// a system with another configuration
+CheckpointPosition CheckpointCodec::Decode(std::string_view data,
+                                           CybercafeMonitoringSystem& system) {
+  using ClientState = CybercafeMonitoringSystem::ClientState;
+
+  if (not data.starts_with(kMagic)) ThrowCorrupt("not a checkpoint");
+  Reader header(data.substr(kMagic.size()));
+  if (header.Get<uint32_t>() != kCheckpointVersion)
+    throw std::runtime_error("Unsupported checkpoint version");
+
+  const auto payload_size = header.Get<uint64_t>();
+  const auto checksum = header.Get<uint64_t>();
+  if (data.size() < kHeaderSize or data.size() - kHeaderSize != payload_size)
+    ThrowCorrupt("bad size");
+
+  const std::string_view payload = data.substr(kHeaderSize);
+  if (ChecksumInput(payload) != checksum) ThrowCorrupt("bad checksum");
+
+  Reader reader(payload);
+  if (reader.Get<int32_t>() != ToMinutes(system.opening_time_) or
+      reader.Get<int32_t>() != ToMinutes(system.closing_time_) or
+      reader.Get<int32_t>() != system.tables_count_ or
+      reader.Get<int32_t>() != system.hourly_rate_)
+    throw std::runtime_error("Checkpoint of another configuration");
+
+  CheckpointPosition position;
+  position.input_offset = reader.Get<uint64_t>();
+  position.events = reader.Get<uint64_t>();
+  const bool has_last_event = reader.Get<uint8_t>() != 0;
+  const auto last_event_minutes = reader.Get<int32_t>();
+  if (has_last_event) position.last_event_minutes = last_event_minutes;
+  position.input_size = reader.Get<uint64_t>();
+  position.input_checksum = reader.Get<uint64_t>();
+
+  const auto total_revenue = reader.Get<int64_t>();
+
+  // The state is rebuilt aside and replaces the current one only when the
+  // whole checkpoint is read, so a bad file leaves the system untouched
+  ClientNameInterner client_names;
+  std::vector<ClientState> clients(reader.GetCount(4 + 4 + 1));
+  TableOccupancyIndex tables_occupancy(system.tables_count_);
+  for (ClientId client = 0; client != clients.size(); ++client) {
+    std::string_view name = reader.GetBytes();
+    if (not IsClientNameValid(name) or client_names.Intern(name) != client)
+      ThrowCorrupt("bad client name");
+
+    clients[client].table_id = reader.Get<int32_t>();
+    clients[client].inside = reader.Get<uint8_t>() != 0;
+
+    const int table_id = clients[client].table_id;
+    if (table_id == 0) continue;
+    if (table_id < 0 or table_id > system.tables_count_ or
+        tables_occupancy.IsOccupied(table_id) or not clients[client].inside)
+      ThrowCorrupt("bad seating");
+    tables_occupancy.Occupy(table_id, client);
+  }
+
+  WaitingQueue waiting_clients;
+  for (uint32_t i = 0, count = reader.GetCount(sizeof(ClientId)); i != count;
+       ++i) {
+    const auto client = reader.Get<ClientId>();
+    if (client >= clients.size() or not clients[client].inside or
+        clients[client].table_id != 0 or
+        not waiting_clients.PushBack(client))
+      ThrowCorrupt("bad waiting queue");
+  }
+
+  struct TableStats {
+    int32_t session_start;
+
+    int64_t used_minutes;
+
+    int64_t revenue;
+  };
+  std::vector<TableStats> tables_stats(
+      static_cast<size_t>(system.tables_count_));
+  for (auto& table : tables_stats) {
+    table.session_start = reader.Get<int32_t>();
+    table.used_minutes = reader.Get<int64_t>();
+    table.revenue = reader.Get<int64_t>();
+  }
+
+  OccupancyTimeline timeline;
+  for (auto change : {&OccupancyTimeline::ChangeOccupiedTables,
+                      &OccupancyTimeline::ChangeWaitingClients}) {
+    for (uint32_t i = 0, count = reader.GetCount(4 + 4); i != count; ++i) {
+      const auto minute = reader.Get<int32_t>();
+      const auto delta = reader.Get<int32_t>();
+      if (minute < 0 or minute >= MinuteSeries::kMinutesPerDay)
+        ThrowCorrupt("bad timeline");
+      (timeline.*change)(minute, delta);
+    }
+  }
+
+  if (not reader.Empty()) ThrowCorrupt("trailing data");
+
+  system.client_names_ = std::move(client_names);
+  system.clients_ = std::move(clients);
+  system.tables_occupancy_ = std::move(tables_occupancy);
+  system.waiting_clients_ = std::move(waiting_clients);
+  for (int table_id = 1; table_id <= system.tables_count_; ++table_id) {
+    const TableStats& table = tables_stats[table_id - 1];
+    system.tables_stats_.Restore(table_id, table.session_start,
+                                 table.used_minutes, table.revenue);
+  }
+  system.occupancy_timeline_ = std::move(timeline);
+  system.total_revenue_ = total_revenue;
+
+  return position;
+}
+
+// Writes the checkpoint into a temporary file next to the path, syncs it to
+// the disk and renames it over the path
+void WriteCheckpoint(const CybercafeMonitoringSystem& system,
+                     const CheckpointPosition& position,
+                     const std::filesystem::path& path) {
+  std::string data;
+  CheckpointCodec::Encode(system, position, data);
+
+  std::filesystem::path temporary_path = path;
+  temporary_path += ".tmp";
+
+  std::FILE* file = std::fopen(temporary_path.string().c_str(), "wb");
+  if (file == nullptr)
+    throw std::runtime_error(
+        std::format("Cannot open file: {}", temporary_path.string()));
+
+  const bool written =
+      std::fwrite(data.data(), 1, data.size(), file) == data.size() and
+      SyncFile(file);
+  const bool closed = std::fclose(file) == 0;
+  if (not written or not closed) {
+    std::error_code error;
+    std::filesystem::remove(temporary_path, error);
+    throw std::runtime_error(
+        std::format("Cannot write checkpoint: {}", path.string()));
+  }
+
+  std::filesystem::rename(temporary_path, path);
+  SyncDirectory(path.parent_path());
+}
+
+// Maps the checkpoint and restores its state into a system built with the
+// same configuration
+CheckpointPosition LoadCheckpoint(const std::filesystem::path& path,
+                                  CybercafeMonitoringSystem& system) {
+  MappedFile mapped_file(path);
+  return CheckpointCodec::Decode(mapped_file.View(), system);
+}
+
+}  // namespace cybercafe_monitoring_system
@@ -0,0 +1,40 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Mapping of client names to dense integer ids
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/client_name_interner.h"
+
+#include <memory>
+#include <memory_resource>
+
+#include "include/day_arena.h"
+
+namespace cybercafe_monitoring_system {
+
+ClientNameInterner::ClientNameInterner()
+    : arena_(std::make_unique<DayArena>()), ids_(MakeIdMap(0)) {}
+
+// Forgets every name in O(1) by resetting the arena. The map is made again
+// with room for as many names as there were
+void ClientNameInterner::Clear() {
+  const size_t names_count = names_.size();
+  names_.clear();
+  arena_->Reset();
+  ids_ = MakeIdMap(names_count);
+}
+
+// Makes an empty map in the arena
+ClientNameInterner::IdMap* ClientNameInterner::MakeIdMap(size_t names_count) {
+  IdMap* ids =
+      std::pmr::polymorphic_allocator<>(arena_.get()).new_object<IdMap>();
+  ids->reserve(names_count);
+  return ids;
+}
+
+}  // namespace cybercafe_monitoring_system
@@ -0,0 +1,85 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Radix sorting of clients by name
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/client_name_sorter.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "include/client_name_interner.h"
+#include "include/client_name_validator.h"
+
+namespace cybercafe_monitoring_system {
+
+// Names must be valid client names
+void ClientNameSorter::Sort(std::span<ClientId> clients,
+                            const ClientNameInterner& names) {
+  keys_.clear();
+  items_.clear();
+
+  for (ClientId client : clients) {
+    std::string_view name = names.GetName(client);
+    items_.push_back(Item{static_cast<uint32_t>(keys_.size()),
+                          static_cast<uint32_t>(name.size()), client});
+    for (char c : name)
+      keys_.push_back(GetClientNameCharacterKey(c));
+  }
+
+  scratch_.resize(items_.size());
+  SortRange(0, items_.size(), 0);
+
+  std::ranges::transform(items_, clients.begin(),
+                         [](const Item& item) { return item.client; });
+}
+
+// Sorts items [begin, end), equal in the first depth characters
+void ClientNameSorter::SortRange(size_t begin, size_t end, size_t depth) {
+  if (end - begin <= kComparisonSortSize) {
+    // A name that is a prefix of another one goes first, as 0 past the end
+    // is less than any character key
+    std::sort(items_.begin() + begin, items_.begin() + end,
+              [this, depth](const Item& first, const Item& second) {
+                const uint8_t* first_key = keys_.data() + first.key_offset;
+                const uint8_t* second_key = keys_.data() + second.key_offset;
+                return std::lexicographical_compare(
+                    first_key + std::min<size_t>(depth, first.key_size),
+                    first_key + first.key_size,
+                    second_key + std::min<size_t>(depth, second.key_size),
+                    second_key + second.key_size);
+              });
+    return;
+  }
+
+  // Bucket 0 holds the names ending before the depth
+  std::array<size_t, kClientNameAlphabetSize + 2> bucket_begin{};
+  for (size_t i = begin; i != end; ++i)
+    ++bucket_begin[KeyAt(items_[i], depth) + 1];
+
+  bucket_begin[0] = begin;
+  for (size_t bucket = 1; bucket != bucket_begin.size(); ++bucket)
+    bucket_begin[bucket] += bucket_begin[bucket - 1];
+
+  std::array<size_t, kClientNameAlphabetSize + 2> next = bucket_begin;
+  for (size_t i = begin; i != end; ++i)
+    scratch_[next[KeyAt(items_[i], depth)]++] = items_[i];
+  std::copy(scratch_.begin() + begin, scratch_.begin() + end,
+            items_.begin() + begin);
+
+  // Names are unique, so at most one ends here and bucket 0 is done
+  for (size_t bucket = 1; bucket <= kClientNameAlphabetSize; ++bucket)
+    if (bucket_begin[bucket + 1] - bucket_begin[bucket] > 1)
+      SortRange(bucket_begin[bucket], bucket_begin[bucket + 1], depth + 1);
+}
+
+}  // namespace cybercafe_monitoring_system
@@ -0,0 +1,213 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Client name alphabet and its vectorized checks
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/client_name_validator.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CYBERCAFE_SIMD_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+// Compiled for AVX2 function by function, used only if the processor has it
+#define CYBERCAFE_SIMD_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+namespace {
+
+using cybercafe_monitoring_system::GetClientNameCharacterKey;
+using cybercafe_monitoring_system::SimdLevel;
+
+bool AreCharactersValidScalar(std::string_view name) {
+  return std::ranges::all_of(
+      name, [](char c) { return GetClientNameCharacterKey(c) != 0; });
+}
+
+size_t GetCommonPrefixSizeScalar(std::string_view first,
+                                 std::string_view second, size_t from) {
+  const size_t size = std::min(first.size(), second.size());
+  while (from != size and first[from] == second[from]) ++from;
+  return from;
+}
+
+#ifdef CYBERCAFE_SIMD_SSE2
+
+// All characters are below 0x80, so bytes with the high bit set are negative
+// in the signed compares and fall out of every range
+inline __m128i InRangeSse2(__m128i block, char low, char high) {
+  return _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(low - 1)),
+                       _mm_cmplt_epi8(block, _mm_set1_epi8(high + 1)));
+}
+
+inline bool IsBlockValidSse2(const char* data) {
+  const __m128i block =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  const __m128i valid = _mm_or_si128(
+      _mm_or_si128(InRangeSse2(block, 'a', 'z'), InRangeSse2(block, '0', '9')),
+      _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('_')),
+                   _mm_cmpeq_epi8(block, _mm_set1_epi8('-'))));
+  return _mm_movemask_epi8(valid) == 0xFFFF;
+}
+
+bool AreCharactersValidSse2(std::string_view name) {
+  if (name.size() < 16) return AreCharactersValidScalar(name);
+
+  for (size_t i = 0; i + 16 <= name.size(); i += 16)
+    if (not IsBlockValidSse2(name.data() + i)) return false;
+
+  // The tail is checked by the last full block, overlapping checked bytes
+  return IsBlockValidSse2(name.data() + name.size() - 16);
+}
+
+size_t GetCommonPrefixSizeSse2(std::string_view first,
+                               std::string_view second) {
+  const size_t size = std::min(first.size(), second.size());
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i equal = _mm_cmpeq_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(first.data() + i)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(second.data() + i)));
+    const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(equal));
+    if (mask != 0xFFFF) return i + std::countr_one(mask);
+  }
+
+  return GetCommonPrefixSizeScalar(first, second, i);
+}
+
+#endif
+
+#ifdef CYBERCAFE_SIMD_AVX2
+
+__attribute__((target("avx2"))) inline __m256i InRangeAvx2(__m256i block,
+                                                           char low,
+                                                           char high) {
+  return _mm256_and_si256(
+      _mm256_cmpgt_epi8(block, _mm256_set1_epi8(low - 1)),
+      _mm256_cmpgt_epi8(_mm256_set1_epi8(high + 1), block));
+}
+
+__attribute__((target("avx2"))) inline bool IsBlockValidAvx2(
+    const char* data) {
+  const __m256i block =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  const __m256i valid = _mm256_or_si256(
+      _mm256_or_si256(InRangeAvx2(block, 'a', 'z'),
+                      InRangeAvx2(block, '0', '9')),
+      _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('_')),
+                      _mm256_cmpeq_epi8(block, _mm256_set1_epi8('-'))));
+  return _mm256_movemask_epi8(valid) == -1;
+}
+
+__attribute__((target("avx2"))) bool AreCharactersValidAvx2(
+    std::string_view name) {
+  if (name.size() < 32) return AreCharactersValidSse2(name);
+
+  for (size_t i = 0; i + 32 <= name.size(); i += 32)
+    if (not IsBlockValidAvx2(name.data() + i)) return false;
+
+  // The tail is checked by the last full block, overlapping checked bytes
+  return IsBlockValidAvx2(name.data() + name.size() - 32);
+}
+
+__attribute__((target("avx2"))) size_t GetCommonPrefixSizeAvx2(
+    std::string_view first, std::string_view second) {
+  const size_t size = std::min(first.size(), second.size());
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i equal = _mm256_cmpeq_epi8(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first.data() + i)),
+        _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(second.data() + i)));
+    const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(equal));
+    if (mask != 0xFFFFFFFF) return i + std::countr_one(mask);
+  }
+
+  return i + GetCommonPrefixSizeSse2(first.substr(i), second.substr(i));
+}
+
+#endif
+
+using Validator = bool (*)(std::string_view);
+
+using PrefixMeter = size_t (*)(std::string_view, std::string_view);
+
+Validator GetValidator(SimdLevel level) {
+  switch (level) {
+#ifdef CYBERCAFE_SIMD_AVX2
+    case SimdLevel::kAvx2:
+      return AreCharactersValidAvx2;
+#endif
+#ifdef CYBERCAFE_SIMD_SSE2
+    case SimdLevel::kSse2:
+      return AreCharactersValidSse2;
+#endif
+    default:
+      return AreCharactersValidScalar;
+  }
+}
+
+PrefixMeter GetPrefixMeter(SimdLevel level) {
+  switch (level) {
+#ifdef CYBERCAFE_SIMD_AVX2
+    case SimdLevel::kAvx2:
+      return GetCommonPrefixSizeAvx2;
+#endif
+#ifdef CYBERCAFE_SIMD_SSE2
+    case SimdLevel::kSse2:
+      return GetCommonPrefixSizeSse2;
+#endif
+    default:
+      return [](std::string_view first, std::string_view second) {
+        return GetCommonPrefixSizeScalar(first, second, 0);
+      };
+  }
+}
+
+}  // namespace
+
+namespace cybercafe_monitoring_system {
+
+// The widest level supported by both the build and the processor
+SimdLevel GetSupportedSimdLevel() {
+#ifdef CYBERCAFE_SIMD_AVX2
+  if (__builtin_cpu_supports("avx2")) return SimdLevel::kAvx2;
+#endif
+#ifdef CYBERCAFE_SIMD_SSE2
+  return SimdLevel::kSse2;
+#else
+  return SimdLevel::kScalar;
+#endif
+}
+
+// Checks every character with the given level, which must be supported
+bool AreClientNameCharactersValid(std::string_view name, SimdLevel level) {
+  return GetValidator(level)(name);
+}
+
+// The same with the widest supported level, chosen once
+bool AreClientNameCharactersValid(std::string_view name) {
+  static const Validator validator = GetValidator(GetSupportedSimdLevel());
+  return validator(name);
+}
+
+// Length of the common prefix of the names, compared 16 or 32 bytes per step
+size_t GetCommonPrefixSize(std::string_view first, std::string_view second) {
+  static const PrefixMeter prefix_meter =
+      GetPrefixMeter(GetSupportedSimdLevel());
+  return prefix_meter(first, second);
+}
+
+}  // namespace cybercafe_monitoring_system
@@ -11,191 +11,334 @@
 #include "include/cybercafe_monitoring_system.h"
 
 #include <algorithm>
-#include <cctype>
 #include <chrono>
-#include <deque>
+#include <cstdint>
 #include <format>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <string_view>
-#include <unordered_map>
 #include <vector>
 
+#include "include/client_name_interner.h"
+#include "include/output_sink.h"
+#include "include/system_instruments.h"
+#include "include/table_occupancy_index.h"
+#include "include/waiting_queue.h"
+
 namespace {
 
+using cybercafe_monitoring_system::OutputSink;
 using cybercafe_monitoring_system::TimePoint;
 
 // Prints time in HH:MM format
-void PrintTimePoint(const auto& time_point) {
+void PrintTimePoint(OutputSink& output, const auto& time_point) {
   auto dp = std::chrono::floor<std::chrono::days>(time_point);
   auto time = std::chrono::hh_mm_ss(time_point - dp);
-  std::cout << std::format("{:%H:%M}", time);
+  output.Print("{:%H:%M}", time);
 }
 
 // Prints minutes in HH:MM format
-void PrintDurationAsHHMM(const std::chrono::minutes& duration) {
+void PrintDurationAsHHMM(OutputSink& output,
+                         const std::chrono::minutes& duration) {
   auto total_hours = duration.count() / 60;
   auto total_mins = duration.count() % 60;
 
-  std::cout << std::setfill('0') << std::setw(2) << total_hours << ":"
-            << std::setw(2) << total_mins;
+  output.Print("{:02}:{:02}", total_hours, total_mins);
+}
+
+// Prints "HH:MM <id> "
+void PrintEventHeader(
+    OutputSink& output, int64_t minutes,
+    cybercafe_monitoring_system::CybercafeMonitoringSystem::Event::Id id) {
+  output.Print("{:02}:{:02} {} ", minutes / 60 % 24, minutes % 60,
+               static_cast<int>(id));
+}
+
+void PrintTimeLine(OutputSink& output, const TimePoint& time) {
+  PrintTimePoint(output, time);
+  output.Put('\n');
+}
+
+void PrintEventLine(
+    OutputSink& output, int32_t minutes,
+    cybercafe_monitoring_system::CybercafeMonitoringSystem::Event::Id id,
+    std::string_view client_name, int32_t table_id) {
+  using Id = cybercafe_monitoring_system::CybercafeMonitoringSystem::Event::Id;
+
+  PrintEventHeader(output, minutes, id);
+  output.Write(client_name);
+
+  if (id == Id::k2 or id == Id::k12) output.Print(" {}", table_id);
+  output.Put('\n');
+}
+
+void PrintErrorLine(OutputSink& output, int32_t minutes,
+                    cybercafe_monitoring_system::ErrorReason reason) {
+  PrintEventHeader(
+      output, minutes,
+      cybercafe_monitoring_system::CybercafeMonitoringSystem::Event::Id::k13);
+  output.Write(cybercafe_monitoring_system::GetErrorReasonText(reason));
+  output.Put('\n');
+}
+
+// No newline after the last table, so every line but the first starts with one
+void PrintTableStatsLine(OutputSink& output, int32_t table_id,
+                         int64_t revenue, int64_t used_minutes) {
+  if (table_id != 1) output.Put('\n');
+
+  output.Print("{} {} ", table_id, revenue);
+  PrintDurationAsHHMM(output, std::chrono::minutes{used_minutes});
 }
 
 }  // namespace
 
 namespace cybercafe_monitoring_system {
 
-// Prints event header
-void CybercafeMonitoringSystem::Event::Print() const {
-  auto since_epoch = GetTime().time_since_epoch();
+// Prints event header and body
+void CybercafeMonitoringSystem::Event::Print(OutputSink& output) const {
+  PrintEventHeader(output, GetTime().time_since_epoch().count(), GetId());
+  PrintEventBody(output);
+}
 
-  auto hours = std::chrono::duration_cast<std::chrono::hours>(since_epoch);
-  since_epoch -= hours;
-  auto minutes = std::chrono::duration_cast<std::chrono::minutes>(since_epoch);
+void CybercafeMonitoringSystem::ClientArrivedEvent::Handle(
+    CybercafeMonitoringSystem& system) {
+  system.Handle(system.MakeRecord(time_, id_, client_name_, 0));
+}
 
-  std::cout << std::setfill('0') << std::setw(2) << hours.count() % 24 << ":"
-            << std::setw(2) << minutes.count() % 60 << " "
-            << static_cast<int>(GetId()) << " ";
+void CybercafeMonitoringSystem::ClientSatAtTableEvent::Handle(
+    CybercafeMonitoringSystem& system) {
+  system.Handle(system.MakeRecord(time_, id_, client_name_, table_id_));
+}
 
-  PrintEventBody();
+void CybercafeMonitoringSystem::ClientWaitingEvent::Handle(
+    CybercafeMonitoringSystem& system) {
+  system.Handle(system.MakeRecord(time_, id_, client_name_, 0));
 }
 
-void CybercafeMonitoringSystem::ClientArrivedEvent::Handle(
+void CybercafeMonitoringSystem::ClientLeftEvent::Handle(
     CybercafeMonitoringSystem& system) {
-  Print();
+  system.Handle(system.MakeRecord(time_, id_, client_name_, 0));
+}
+
+// Makes the record of an incoming event, interning the client name
+CybercafeMonitoringSystem::EventRecord
+CybercafeMonitoringSystem::MakeEventRecord(const TimePoint& time, Event::Id id,
+                                           std::string_view client_name,
+                                           int table_id) {
+  using Id = Event::Id;
+
+  if (id != Id::k1 and id != Id::k2 and id != Id::k3 and id != Id::k4)
+    throw std::invalid_argument(
+        std::format("Invalid incoming id: {}", static_cast<int>(id)));
+
+  if (not IsClientNameValid(client_name))
+    throw std::invalid_argument(
+        std::format("Invalid client name: {}", client_name));
+
+  return MakeRecord(time, id, client_name, id == Id::k2 ? table_id : 0);
+}
+
+// Prints the record and handles it like the matching event class would
+void CybercafeMonitoringSystem::Handle(const EventRecord& record) {
+  using Id = Event::Id;
+
+  PrintEventRecord(record);
+  instruments_.CountEvent(static_cast<int>(record.id));
+
+  switch (record.id) {
+    case Id::k1:
+      HandleClientArrived(record);
+      break;
+    case Id::k2:
+    case Id::k12:
+      HandleClientSatAtTable(record);
+      break;
+    case Id::k3:
+      HandleClientWaiting(record);
+      break;
+    case Id::k4:
+    case Id::k11:
+      HandleClientLeft(record);
+      break;
+    default:
+      throw std::invalid_argument(
+          std::format("Invalid event id {}", static_cast<int>(record.id)));
+  }
+}
 
-  if (system.clients_.contains(client_name_)) {
-    ErrorEvent(GetTime(), "YouShallNotPass").Print();
+// Prints record header and body
+void CybercafeMonitoringSystem::PrintEventRecord(
+    const EventRecord& record) const {
+  const std::string_view client_name = client_names_.GetName(record.client);
+  if (output_records_ == nullptr) {
+    PrintEventLine(*output_, record.minutes, record.id, client_name,
+                   record.table_id);
     return;
   }
 
-  if (not system.IsWorking(GetTime())) {
-    ErrorEvent(GetTime(), "NotOpenYet").Print();
+  OutputRecord& output_record = output_records_->records.emplace_back();
+  output_record.kind = OutputRecord::Kind::kEvent;
+  output_record.id = record.id;
+  output_record.minutes = record.minutes;
+  output_record.table_id = record.table_id;
+  output_record.name_offset =
+      static_cast<uint32_t>(output_records_->names.size());
+  output_record.name_size = static_cast<uint32_t>(client_name.size());
+  output_records_->names.append(client_name);
+}
+
+// Prints k13 with the reason
+void CybercafeMonitoringSystem::PrintError(int32_t minutes,
+                                           ErrorReason reason) {
+  instruments_.CountEvent(static_cast<int>(Event::Id::k13));
+  instruments_.CountError(reason);
+
+  if (output_records_ == nullptr) {
+    PrintErrorLine(*output_, minutes, reason);
     return;
   }
 
-  system.clients_.insert(client_name_);
+  OutputRecord& output_record = output_records_->records.emplace_back();
+  output_record.kind = OutputRecord::Kind::kError;
+  output_record.reason = reason;
+  output_record.minutes = minutes;
 }
 
-void CybercafeMonitoringSystem::ClientSatAtTableEvent::Handle(
-    CybercafeMonitoringSystem& system) {
-  Print();
-
-  switch (static_cast<Id>(id_)) {
-    case Id::k2: {
-      if (!system.IsTableFree(table_id_)) {
-        ErrorEvent(GetTime(), "PlaceIsBusy").Print();
-        return;
-      }
-
-      if (not system.clients_.contains(client_name_)) {
-        ErrorEvent(GetTime(), "ClientUnknown").Print();
-        return;
-      }
-
-      if (system.clients_at_table_.contains(client_name_)) {
-        system.ProcessClientDeparture(client_name_, time_);
-        system.clients_.insert(client_name_);
-      }
-
-      system.clients_at_table_[client_name_] = table_id_;
-      system.tables_current_using_since_[table_id_] = time_;
-    } break;
-
-    case Id::k12: {
-      system.clients_at_table_[client_name_] = table_id_;
-      system.tables_current_using_since_[table_id_] = time_;
-    } break;
-    default:
-      throw std::invalid_argument(
-          std::format("Invalid event id {}", static_cast<int>(id_)));
+void CybercafeMonitoringSystem::HandleClientArrived(const EventRecord& record) {
+  [[maybe_unused]] auto timer =
+      instruments_.Time(InstrumentedHandler::kClientArrived);
+  ClientState& client = clients_[record.client];
+
+  if (client.inside) {
+    PrintError(record.minutes, ErrorReason::kYouShallNotPass);
+    return;
   }
+
+  if (not IsWorking(ToTimePoint(record.minutes))) {
+    PrintError(record.minutes, ErrorReason::kNotOpenYet);
+    return;
+  }
+
+  client.inside = true;
 }
 
-void CybercafeMonitoringSystem::ClientWaitingEvent::Handle(
-    CybercafeMonitoringSystem& system) {
-  Print();
+void CybercafeMonitoringSystem::HandleClientSatAtTable(
+    const EventRecord& record) {
+  [[maybe_unused]] auto timer =
+      instruments_.Time(InstrumentedHandler::kClientSatAtTable);
+  const TimePoint time = ToTimePoint(record.minutes);
+
+  if (record.id == Event::Id::k2) {
+    if (!IsTableFree(record.table_id)) {
+      PrintError(record.minutes, ErrorReason::kPlaceIsBusy);
+      return;
+    }
+
+    if (not clients_[record.client].inside) {
+      PrintError(record.minutes, ErrorReason::kClientUnknown);
+      return;
+    }
+
+    if (clients_[record.client].table_id != 0) {
+      ProcessClientDeparture(record.client, time);
+      clients_[record.client].inside = true;
+    }
+  }
 
-  if (system.IsAvailableTableExists()) {
-    ErrorEvent(GetTime(), "ICanWaitNoLonger!").Print();
+  clients_[record.client].table_id = record.table_id;
+  tables_occupancy_.Occupy(record.table_id, record.client);
+  tables_stats_.StartSession(record.table_id, record.minutes);
+  occupancy_timeline_.ChangeOccupiedTables(record.minutes, 1);
+  instruments_.ObserveOccupiedTables(tables_occupancy_.GetOccupiedCount());
+}
+
+void CybercafeMonitoringSystem::HandleClientWaiting(const EventRecord& record) {
+  [[maybe_unused]] auto timer =
+      instruments_.Time(InstrumentedHandler::kClientWaiting);
+
+  if (IsAvailableTableExists()) {
+    PrintError(record.minutes, ErrorReason::kICanWaitNoLonger);
     return;
   }
 
-  if (system.clients_at_table_.contains(client_name_)) {
-    ErrorEvent(GetTime(), "YouAlreadyAtTable!").Print();
+  if (clients_[record.client].table_id != 0) {
+    PrintError(record.minutes, ErrorReason::kYouAlreadyAtTable);
     return;
   }
 
-  if (static_cast<int>(system.waiting_clients_.size()) >=
-      system.tables_count_) {
-    ClientLeftEvent(GetTime(), client_name_, Event::Type::kOutgoing)
-        .Handle(system);
+  if (static_cast<int>(waiting_clients_.Size()) >= tables_count_) {
+    Handle(EventRecord{record.minutes, Event::Id::k11, record.client, 0});
     return;
   }
 
-  if (not system.clients_.contains(client_name_)) {
-    ErrorEvent(GetTime(), "ClientUnknown").Print();
+  if (not clients_[record.client].inside) {
+    PrintError(record.minutes, ErrorReason::kClientUnknown);
     return;
   }
 
-  system.waiting_clients_.push_back(client_name_);
+  // A client repeating the request keeps the original place in the queue
+  if (waiting_clients_.PushBack(record.client))
+    occupancy_timeline_.ChangeWaitingClients(record.minutes, 1);
+  instruments_.ObserveWaitingClients(waiting_clients_.Size());
 }
 
-void CybercafeMonitoringSystem::ClientLeftEvent::Handle(
-    CybercafeMonitoringSystem& system) {
-  Print();
-
-  switch (static_cast<Id>(id_)) {
-    case Id::k4: {
-      if (not system.clients_.contains(client_name_)) {
-        ErrorEvent(GetTime(), "ClientUnknown").Print();
-        return;
-      }
-
-      if (not system.clients_at_table_.contains(client_name_)) {
-        system.clients_.erase(client_name_);
-        auto [erase_begin_it, erase_end_it] =
-            std::ranges::remove(system.waiting_clients_, client_name_);
-        system.waiting_clients_.erase(erase_begin_it, erase_end_it);
-        return;
-      }
-
-      int table_id = system.clients_at_table_[client_name_];
-      system.ProcessClientDeparture(client_name_, GetTime());
-
-      if (not system.waiting_clients_.empty()) {
-        ClientSatAtTableEvent(GetTime(), system.waiting_clients_.front(),
-                              table_id, Event::Type::kOutgoing)
-            .Handle(system);
-        system.waiting_clients_.pop_front();
-      }
-    } break;
-    case Id::k11: {
-      if (not system.clients_at_table_.contains(client_name_)) {
-        system.clients_.erase(client_name_);
-        auto [erase_begin_it, erase_end_it] =
-            std::ranges::remove(system.waiting_clients_, client_name_);
-        system.waiting_clients_.erase(erase_begin_it, erase_end_it);
-        return;
-      }
-
-      system.ProcessClientDeparture(client_name_, GetTime());
-    } break;
-    default:
-      throw std::invalid_argument(
-          std::format("Invalid event id {}", static_cast<int>(id_)));
+void CybercafeMonitoringSystem::HandleClientLeft(const EventRecord& record) {
+  [[maybe_unused]] auto timer =
+      instruments_.Time(InstrumentedHandler::kClientLeft);
+
+  if (record.id == Event::Id::k4 and not clients_[record.client].inside) {
+    PrintError(record.minutes, ErrorReason::kClientUnknown);
+    return;
+  }
+
+  if (clients_[record.client].table_id == 0) {
+    clients_[record.client].inside = false;
+    if (waiting_clients_.Contains(record.client)) {
+      waiting_clients_.Remove(record.client);
+      occupancy_timeline_.ChangeWaitingClients(record.minutes, -1);
+    }
+    return;
+  }
+
+  int table_id = clients_[record.client].table_id;
+  ProcessClientDeparture(record.client, ToTimePoint(record.minutes));
+
+  if (record.id == Event::Id::k4 and not waiting_clients_.Empty()) {
+    Handle(EventRecord{record.minutes, Event::Id::k12, waiting_clients_.Front(),
+                       table_id});
+    waiting_clients_.PopFront();
+    occupancy_timeline_.ChangeWaitingClients(record.minutes, -1);
   }
 }
 
 CybercafeMonitoringSystem::CybercafeMonitoringSystem(
     const TimePoint& opening_time, const TimePoint& closing_time,
     int tables_count, int hourly_rate)
+    : CybercafeMonitoringSystem(opening_time, closing_time, tables_count,
+                                hourly_rate, nullptr) {}
+
+CybercafeMonitoringSystem::CybercafeMonitoringSystem(
+    const TimePoint& opening_time, const TimePoint& closing_time,
+    int tables_count, int hourly_rate, OutputSink& output)
+    : CybercafeMonitoringSystem(opening_time, closing_time, tables_count,
+                                hourly_rate, &output) {}
+
+CybercafeMonitoringSystem::CybercafeMonitoringSystem(
+    const TimePoint& opening_time, const TimePoint& closing_time,
+    int tables_count, int hourly_rate, OutputSink* output)
     : hourly_rate_(hourly_rate),
+      own_output_(output == nullptr
+                      ? std::make_unique<StreamOutputSink>(std::cout)
+                      : nullptr),
+      output_(output == nullptr ? own_output_.get() : output),
       opening_time_(opening_time),
       closing_time_(closing_time),
-      tables_count_(tables_count) {
+      tables_count_(tables_count),
+      tables_occupancy_(tables_count),
+      tables_stats_(tables_count) {
   if (tables_count < 1)
     throw std::invalid_argument(
         std::format("Invalid tables count: {}", tables_count));
@@ -204,18 +347,48 @@ CybercafeMonitoringSystem::CybercafeMonitoringSystem(
 // Prints the desk number, its revenue for the day and the time it was
 // occupied during the working day
 void CybercafeMonitoringSystem::PrintClosingStats() const {
-  PrintTimePoint(closing_time_);
-  std::cout << std::endl;
-
-  for (int table_id = 1; table_id < tables_count_; ++table_id) {
-    std::cout << table_id << " " << tables_daily_revenue_.at(table_id) << " ";
-    PrintDurationAsHHMM(tables_daily_using_.at(table_id));
-    std::cout << std::endl;
+  PrintTime(closing_time_);
+
+  // One linear pass over the dense arrays
+  for (int table_id = 1; table_id <= tables_count_; ++table_id) {
+    if (output_records_ == nullptr) {
+      PrintTableStatsLine(*output_, table_id,
+                          tables_stats_.GetRevenue(table_id),
+                          tables_stats_.GetUsedMinutes(table_id));
+      continue;
+    }
+
+    OutputRecord& output_record = output_records_->records.emplace_back();
+    output_record.kind = OutputRecord::Kind::kTableStats;
+    output_record.table_id = table_id;
+    output_record.revenue = tables_stats_.GetRevenue(table_id);
+    output_record.used_minutes = tables_stats_.GetUsedMinutes(table_id);
   }
+}
 
-  std::cout << tables_count_ << " " << tables_daily_revenue_.at(tables_count_)
-            << " ";
-  PrintDurationAsHHMM(tables_daily_using_.at(tables_count_));
+// Prints the records in their order
+void CybercafeMonitoringSystem::PrintOutputRecords(
+    const OutputRecords& records, OutputSink& output) {
+  const std::string_view names = records.names;
+  for (const OutputRecord& record : records.records) {
+    switch (record.kind) {
+      case OutputRecord::Kind::kTime:
+        PrintTimeLine(output, ToTimePoint(record.minutes));
+        break;
+      case OutputRecord::Kind::kEvent:
+        PrintEventLine(output, record.minutes, record.id,
+                       names.substr(record.name_offset, record.name_size),
+                       record.table_id);
+        break;
+      case OutputRecord::Kind::kError:
+        PrintErrorLine(output, record.minutes, record.reason);
+        break;
+      case OutputRecord::Kind::kTableStats:
+        PrintTableStatsLine(output, record.table_id, record.revenue,
+                            record.used_minutes);
+        break;
+    }
+  }
 }
 
 bool CybercafeMonitoringSystem::IsTableFree(int table_id) const {
@@ -223,57 +396,110 @@ bool CybercafeMonitoringSystem::IsTableFree(int table_id) const {
     throw std::invalid_argument(
         std::format("Incorrect table id: {}", table_id));
 
-  for (const auto& [client, table] : clients_at_table_)
-    if (table == table_id) return false;
+  return not tables_occupancy_.IsOccupied(table_id);
+}
+
+// Returns the client sitting at the table or an empty name if it is free
+std::string_view CybercafeMonitoringSystem::GetTableOccupant(
+    int table_id) const {
+  if (table_id < 1 or table_id > tables_count_)
+    throw std::invalid_argument(
+        std::format("Incorrect table id: {}", table_id));
 
-  return true;
+  ClientId client = tables_occupancy_.GetOccupant(table_id);
+  return client == kNoClient ? std::string_view{}
+                             : client_names_.GetName(client);
 }
 
 // Calls when the cybercafe opens
 void CybercafeMonitoringSystem::CybercafeOpen() {
-  for (int i = 1; i <= tables_count_; ++i) {
-    tables_daily_revenue_[i] = 0;
-    tables_daily_using_[i] = std::chrono::minutes{0ll};
-  }
+  tables_stats_.Reset();
+  occupancy_timeline_.Reset();
+  session_ledger_.Clear();
+  instruments_.Reset();
 
-  PrintTimePoint(opening_time_);
-  std::cout << std::endl;
+  PrintTime(opening_time_);
 }
 
 // Calls when the cybercafe closes
 void CybercafeMonitoringSystem::CybercafeClose() {
-  std::vector<std::string> remaining_clients;
-  for (const auto& client : clients_) remaining_clients.push_back(client);
+  SettleRemainingClients();
 
-  std::ranges::sort(remaining_clients, ClientsNameCompare{});
+  PrintClosingStats();
+  if (output_records_ == nullptr) output_->Flush();
+  instruments_.Report();
 
-  for (const auto& client : remaining_clients) {
-    ClientLeftEvent(closing_time_, client, Event::Type::kOutgoing)
-        .Handle(*this);
-  }
+  waiting_clients_.Clear();
+  clients_.clear();
+  client_names_.Clear();
+  session_ledger_.ForgetClientIds();
+}
 
-  PrintClosingStats();
+// Prints the opening or the closing time line
+void CybercafeMonitoringSystem::PrintTime(const TimePoint& time) const {
+  if (output_records_ == nullptr) {
+    PrintTimeLine(*output_, time);
+    return;
+  }
 
-  tables_daily_using_.clear();
-  tables_current_using_since_.clear();
-  tables_daily_revenue_.clear();
+  OutputRecord& output_record = output_records_->records.emplace_back();
+  output_record.kind = OutputRecord::Kind::kTime;
+  output_record.minutes = static_cast<int32_t>(time.time_since_epoch().count());
 }
 
-// Deletes client from database
-void CybercafeMonitoringSystem::ProcessClientDeparture(
-    const std::string& client_name, const TimePoint& time) {
-  int table_id = clients_at_table_.at(client_name);
+// Prints k11 for every client still inside, in the name order, and ends all
+// open sessions at the closing time in one pass over the tables
+void CybercafeMonitoringSystem::SettleRemainingClients() {
+  remaining_clients_.clear();
+  for (ClientId client = 0; client != clients_.size(); ++client)
+    if (clients_[client].inside) remaining_clients_.push_back(client);
 
-  auto usage_duration = time - tables_current_using_since_.at(table_id);
-  tables_daily_using_[table_id] += usage_duration;
+  remaining_clients_sorter_.Sort(remaining_clients_, client_names_);
 
-  int64_t hours = (static_cast<int64_t>(usage_duration.count()) + 59) / 60;
-  tables_daily_revenue_[table_id] += hours * hourly_rate_;
-  total_revenue_ += hours * hourly_rate_;
+  const auto closing_minutes =
+      static_cast<int32_t>(closing_time_.time_since_epoch().count());
+  for (ClientId client : remaining_clients_) {
+    PrintEventRecord(EventRecord{closing_minutes, Event::Id::k11, client, 0});
+    instruments_.CountEvent(static_cast<int>(Event::Id::k11));
+  }
 
-  clients_at_table_.erase(client_name);
-  clients_.erase(client_name);
-  tables_current_using_since_.erase(table_id);
+  // Everyone at a table is inside, so these are exactly their sessions. Each
+  // one is a client departure for the instruments
+  tables_occupancy_.ForEachOccupied([&](int table_id, ClientId client) {
+    [[maybe_unused]] auto timer =
+        instruments_.Time(InstrumentedHandler::kClientDeparture);
+    const int32_t start = tables_stats_.GetSessionStart(table_id);
+    const int64_t charge =
+        tables_stats_.EndSession(table_id, closing_minutes, hourly_rate_);
+    total_revenue_ += charge;
+    session_ledger_.Append(client, client_names_.GetName(client), table_id,
+                           start, closing_minutes, charge);
+  });
+  occupancy_timeline_.ChangeOccupiedTables(
+      closing_minutes, -tables_occupancy_.GetOccupiedCount());
+  occupancy_timeline_.ChangeWaitingClients(
+      closing_minutes, -static_cast<int32_t>(waiting_clients_.Size()));
+  tables_occupancy_.ReleaseAll();
+}
+
+// Deletes client from database
+void CybercafeMonitoringSystem::ProcessClientDeparture(ClientId client,
+                                                       const TimePoint& time) {
+  [[maybe_unused]] auto timer =
+      instruments_.Time(InstrumentedHandler::kClientDeparture);
+  int table_id = clients_[client].table_id;
+  const auto minutes = static_cast<int32_t>(time.time_since_epoch().count());
+
+  const int32_t start = tables_stats_.GetSessionStart(table_id);
+  const int64_t charge =
+      tables_stats_.EndSession(table_id, minutes, hourly_rate_);
+  total_revenue_ += charge;
+  session_ledger_.Append(client, client_names_.GetName(client), table_id,
+                         start, minutes, charge);
+
+  tables_occupancy_.Release(table_id);
+  occupancy_timeline_.ChangeOccupiedTables(minutes, -1);
+  clients_[client] = ClientState{};
 }
 
 }  // namespace cybercafe_monitoring_system
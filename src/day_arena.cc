@@ -0,0 +1,63 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Monotonic memory for the state of one day
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/day_arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+
+namespace cybercafe_monitoring_system {
+
+DayArena::DayArena(size_t first_block_size,
+                   std::pmr::memory_resource* upstream)
+    : upstream_(upstream),
+      first_block_size_(std::max<size_t>(first_block_size, 1)) {}
+
+DayArena::~DayArena() {
+  for (const Block& block : blocks_)
+    upstream_->deallocate(block.data, block.size, alignof(std::max_align_t));
+}
+
+// Bytes of all the blocks taken from the upstream
+size_t DayArena::GetCapacity() const {
+  size_t capacity = 0;
+  for (const Block& block : blocks_) capacity += block.size;
+  return capacity;
+}
+
+// Moves on to the first kept block after the current one that fits the
+// allocation, or takes a new one from the upstream. A kept block too small for
+// the allocation stays unused until the next Reset
+void* DayArena::AllocateInNextBlock(size_t bytes, size_t alignment) {
+  // Blocks are aligned for any fundamental type, so only a stricter alignment
+  // may need extra bytes
+  const size_t needed =
+      bytes + (alignment > alignof(std::max_align_t) ? alignment : 0);
+
+  size_t next = position_ == nullptr ? 0 : block_ + 1;
+  while (next != blocks_.size() and blocks_[next].size < needed) ++next;
+
+  if (next == blocks_.size()) {
+    const size_t size = std::max(
+        blocks_.empty() ? first_block_size_ : blocks_.back().size * 2, needed);
+    blocks_.push_back(Block{
+        static_cast<std::byte*>(
+            upstream_->allocate(size, alignof(std::max_align_t))),
+        size});
+  }
+
+  block_ = next;
+  position_ = blocks_[next].data;
+  end_ = position_ + blocks_[next].size;
+  return do_allocate(bytes, alignment);
+}
+
+}  // namespace cybercafe_monitoring_system
@@ -0,0 +1,327 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Synthetic day logs for load testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/day_log_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "include/output_sink.h"
+#include "include/work_stealing_pool.h"
+
+namespace {
+
+using cybercafe_monitoring_system::ArrivalDistribution;
+using cybercafe_monitoring_system::DayLogOptions;
+using cybercafe_monitoring_system::OutputSink;
+
+// Lines written per client before any is seen: arrival, table or wait,
+// departure
+constexpr double kEventsPerClient = 3;
+
+constexpr uint64_t kNoClient = 0;
+
+// Samples are computed from the raw engine output, so a seed gives the same
+// log with every standard library
+class Random final {
+ public:
+  explicit Random(uint64_t seed) : engine_(seed) {}
+
+  // Uniform in [0, 1)
+  inline double Uniform() {
+    return static_cast<double>(engine_() >> 11) * 0x1.0p-53;
+  }
+
+  // Uniform in [0, bound)
+  inline size_t Index(size_t bound) {
+    return static_cast<size_t>(Uniform() * static_cast<double>(bound));
+  }
+
+  inline double Exponential(double mean) {
+    return -std::log(1 - Uniform()) * mean;
+  }
+
+  uint64_t Poisson(double mean) {
+    if (mean <= 0) return 0;
+
+    // Knuth's method for small means, the normal approximation otherwise
+    if (mean < 30) {
+      const double limit = std::exp(-mean);
+      uint64_t count = 0;
+      for (double product = Uniform(); product > limit; product *= Uniform())
+        ++count;
+      return count;
+    }
+
+    const double normal = std::sqrt(-2 * std::log(1 - Uniform())) *
+                          std::cos(2 * 3.14159265358979323846 * Uniform());
+    return static_cast<uint64_t>(
+        std::max(0.0, std::round(mean + normal * std::sqrt(mean))));
+  }
+
+ private:
+  std::mt19937_64 engine_;
+};
+
+// Simulates the tables of one day and writes the events it produces
+class DayLogSimulator final {
+ public:
+  DayLogSimulator(const DayLogOptions& options, OutputSink& output)
+      : options_(options),
+        output_(output),
+        random_(options.seed),
+        table_clients_(static_cast<size_t>(options.tables_count), kNoClient) {
+    free_tables_.reserve(table_clients_.size());
+    for (int table_id = options.tables_count; table_id >= 1; --table_id)
+      free_tables_.push_back(table_id);
+  }
+
+  uint64_t Run() {
+    const int opening = Minutes(options_.opening_time),
+              closing = Minutes(options_.closing_time);
+
+    output_.Print("{}\n{:02}:{:02} {:02}:{:02}\n{}\n", options_.tables_count,
+                  opening / 60, opening % 60, closing / 60, closing % 60,
+                  options_.hourly_rate);
+
+    const std::vector<double> weights = ArrivalWeights(opening, closing);
+    double remaining_weight = 0;
+    for (double weight : weights) remaining_weight += weight;
+
+    for (int minute = opening; minute < closing; ++minute) {
+      ProcessDepartures(minute);
+
+      // The rate follows the distribution shape and is corrected by the lines
+      // per client seen so far, so the log size stays close to the target
+      const double weight = weights[static_cast<size_t>(minute - opening)];
+      const double events_per_client =
+          clients_count_ == 0 ? kEventsPerClient
+                              : static_cast<double>(events_count_) /
+                                    static_cast<double>(clients_count_);
+      const double remaining_events =
+          static_cast<double>(options_.events_count) -
+          static_cast<double>(events_count_);
+      const double rate = std::max(remaining_events, 0.0) * weight /
+                          remaining_weight / events_per_client;
+      remaining_weight -= weight;
+
+      const uint64_t arrivals = random_.Poisson(rate);
+      for (uint64_t i = 0; i != arrivals; ++i) {
+        ProcessArrival(minute);
+        if (random_.Uniform() < options_.error_ratio * events_per_client)
+          WriteError(minute);
+      }
+    }
+
+    output_.Flush();
+    return events_count_;
+  }
+
+ private:
+  struct Departure {
+    int minute;
+
+    int table_id;
+
+    bool operator>(const Departure& other) const {
+      return minute > other.minute;
+    }
+  };
+
+  inline static int Minutes(const cybercafe_monitoring_system::TimePoint& t) {
+    return static_cast<int>(t.time_since_epoch().count());
+  }
+
+  // Relative arrival rate of every working minute
+  std::vector<double> ArrivalWeights(int opening, int closing) const {
+    std::vector<double> weights(
+        static_cast<size_t>(std::max(closing - opening, 0)), 1.0);
+
+    if (options_.arrivals == ArrivalDistribution::kRushHour) {
+      auto peak = [](int minute, int center, double width, double height) {
+        const double x = (minute - center) / width;
+        return height * std::exp(-x * x);
+      };
+      for (size_t i = 0; i != weights.size(); ++i) {
+        const int minute = opening + static_cast<int>(i);
+        weights[i] += peak(minute, 12 * 60 + 30, 45, 3) +
+                      peak(minute, 18 * 60 + 30, 60, 4);
+      }
+    }
+
+    return weights;
+  }
+
+  void WriteEvent(int minute, int id, uint64_t client, int table_id = 0) {
+    output_.Print("{:02}:{:02} {} client{}", minute / 60, minute % 60, id,
+                  client);
+    if (table_id != 0) output_.Print(" {}", table_id);
+    output_.Put('\n');
+    ++events_count_;
+  }
+
+  // The client sits at the table until the end of the session
+  void Seat(int minute, uint64_t client, int table_id) {
+    table_clients_[static_cast<size_t>(table_id - 1)] = client;
+
+    const auto session = static_cast<int>(
+        random_.Exponential(options_.mean_session_minutes));
+    departures_.push({minute + std::max(session, 1), table_id});
+  }
+
+  // Clients whose session is over leave, the first waiting client takes the
+  // table, as the system does with k12
+  void ProcessDepartures(int minute) {
+    while (not departures_.empty() and departures_.top().minute <= minute) {
+      const int table_id = departures_.top().table_id;
+      departures_.pop();
+
+      WriteEvent(minute, 4, table_clients_[static_cast<size_t>(table_id - 1)]);
+
+      if (waiting_.empty()) {
+        table_clients_[static_cast<size_t>(table_id - 1)] = kNoClient;
+        free_tables_.push_back(table_id);
+      } else {
+        Seat(minute, waiting_.front(), table_id);
+        waiting_.pop_front();
+      }
+    }
+  }
+
+  void ProcessArrival(int minute) {
+    const uint64_t client = next_client_++;
+    ++clients_count_;
+    WriteEvent(minute, 1, client);
+
+    if (not free_tables_.empty()) {
+      const size_t index = random_.Index(free_tables_.size());
+      const int table_id = free_tables_[index];
+      free_tables_[index] = free_tables_.back();
+      free_tables_.pop_back();
+
+      WriteEvent(minute, 2, client, table_id);
+      Seat(minute, client, table_id);
+    } else if (random_.Uniform() < options_.wait_ratio and
+               waiting_.size() < table_clients_.size()) {
+      WriteEvent(minute, 3, client);
+      waiting_.push_back(client);
+    } else {
+      WriteEvent(minute, 4, client);
+    }
+  }
+
+  // An event the system answers with k13 and that changes nothing
+  void WriteError(int minute) {
+    const int table_id =
+        static_cast<int>(random_.Index(table_clients_.size())) + 1;
+    const uint64_t sitting = table_clients_[static_cast<size_t>(table_id - 1)];
+
+    switch (random_.Index(4)) {
+      case 0:
+        // ClientUnknown
+        WriteEvent(minute, 4, next_client_++);
+        break;
+      case 1:
+        // PlaceIsBusy or ClientUnknown for a free table
+        WriteEvent(minute, 2, next_client_++, table_id);
+        break;
+      case 2:
+        // YouShallNotPass
+        if (sitting != kNoClient)
+          WriteEvent(minute, 1, sitting);
+        else
+          WriteEvent(minute, 4, next_client_++);
+        break;
+      default:
+        // ICanWaitNoLonger! or YouAlreadyAtTable!
+        if (sitting != kNoClient)
+          WriteEvent(minute, 3, sitting);
+        else
+          WriteEvent(minute, 4, next_client_++);
+        break;
+    }
+  }
+
+  const DayLogOptions& options_;
+
+  OutputSink& output_;
+
+  Random random_;
+
+  // Client at every table, kNoClient if the table is free
+  std::vector<uint64_t> table_clients_;
+
+  std::vector<int> free_tables_;
+
+  std::deque<uint64_t> waiting_;
+
+  std::priority_queue<Departure, std::vector<Departure>,
+                      std::greater<Departure>>
+      departures_;
+
+  // Client numbers start from 1, kNoClient is 0
+  uint64_t next_client_ = 1;
+
+  uint64_t events_count_ = 0;
+
+  uint64_t clients_count_ = 0;
+};
+
+}  // namespace
+
+namespace cybercafe_monitoring_system {
+
+// Writes a valid input file in the README format
+uint64_t GenerateDayLog(const DayLogOptions& options, OutputSink& output) {
+  if (options.tables_count < 1)
+    throw std::invalid_argument(
+        std::format("Invalid tables count: {}", options.tables_count));
+  if (options.hourly_rate < 1)
+    throw std::invalid_argument(
+        std::format("Invalid hourly rate: {}", options.hourly_rate));
+
+  return DayLogSimulator(options, output).Run();
+}
+
+// Writes venue<v>_day<d>.txt for every venue and day into the directory
+std::vector<std::filesystem::path> GenerateVenueDays(
+    const DayLogOptions& options, int venues_count, int days_count,
+    const std::filesystem::path& output_dir) {
+  std::filesystem::create_directories(output_dir);
+
+  std::vector<std::filesystem::path> paths;
+  for (int venue = 0; venue < venues_count; ++venue)
+    for (int day = 0; day < days_count; ++day)
+      paths.push_back(output_dir /
+                      std::format("venue{:03}_day{:03}.txt", venue, day));
+
+  WorkStealingPool().ForEach(paths.size(), [&](size_t i) {
+    DayLogOptions file_options = options;
+    file_options.seed = options.seed * 0x9E3779B97F4A7C15ull + i + 1;
+
+    FileOutputSink output(paths[i]);
+    GenerateDayLog(file_options, output);
+    output.Close();
+  });
+
+  return paths;
+}
+
+}  // namespace cybercafe_monitoring_system
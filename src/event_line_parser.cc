@@ -0,0 +1,126 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Allocation-free parsing of input data lines
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/event_line_parser.h"
+
+#include <charconv>
+#include <chrono>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+#include "include/cybercafe_monitoring_system.h"
+
+namespace {
+
+// Same set of characters as std::isspace in the "C" locale
+inline bool IsSpace(char c) {
+  return c == ' ' or c == '\t' or c == '\n' or c == '\v' or c == '\f' or
+         c == '\r';
+}
+
+inline bool IsDigit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+
+}  // namespace
+
+namespace cybercafe_monitoring_system {
+
+// Cuts the next line off the front of the text, without the '\n'
+std::string_view NextLine(std::string_view& text) {
+  size_t line_end = text.find('\n');
+  std::string_view line = text.substr(0, line_end);
+  text.remove_prefix(line_end == std::string_view::npos ? text.size()
+                                                        : line_end + 1);
+  return line;
+}
+
+// Cuts the next whitespace separated token off the front of the text. Returns
+// an empty token if there is none
+std::string_view NextToken(std::string_view& text) {
+  size_t token_begin = 0;
+  while (token_begin != text.size() and IsSpace(text[token_begin]))
+    ++token_begin;
+
+  size_t token_end = token_begin;
+  while (token_end != text.size() and not IsSpace(text[token_end]))
+    ++token_end;
+
+  std::string_view token = text.substr(token_begin, token_end - token_begin);
+  text.remove_prefix(token_end);
+
+  return token;
+}
+
+// Reads time in HH:MM format
+TimePoint ParseTime(std::string_view token) {
+  if (token.empty())
+    throw std::invalid_argument("Failed to read time token");
+
+  if (token.size() != 5 or token[2] != ':')
+    throw std::invalid_argument("Invalid time format (expected HH:MM)");
+
+  if (not IsDigit(token[0]) or not IsDigit(token[1]) or
+      not IsDigit(token[3]) or not IsDigit(token[4]))
+    throw std::invalid_argument("Time contains non-digit characters");
+
+  int hours = (token[0] - '0') * 10 + (token[1] - '0'),
+      minutes = (token[3] - '0') * 10 + (token[4] - '0');
+
+  if (hours > 23)
+    throw std::invalid_argument("Hours out of range (0-23)");
+  else if (minutes > 59)
+    throw std::invalid_argument("Minutes out of range (0-59)");
+
+  return TimePoint(std::chrono::minutes{hours * 60 + minutes});
+}
+
+// Reads a whole token as a decimal number
+int ParseInt(std::string_view token) {
+  int value = 0;
+  const char* token_end = token.data() + token.size();
+
+  auto [parse_end, error] = std::from_chars(token.data(), token_end, value);
+  if (error != std::errc{} or parse_end != token_end or token.empty())
+    throw std::invalid_argument("Invalid number");
+
+  return value;
+}
+
+// Reads "<HH:MM> <id> <client name> [table]" without copying the line
+ParsedEventLine ParseEventLine(std::string_view line) {
+  using Id = CybercafeMonitoringSystem::Event::Id;
+
+  ParsedEventLine event;
+  event.time = ParseTime(NextToken(line));
+
+  int event_id = ParseInt(NextToken(line));
+  switch (static_cast<Id>(event_id)) {
+    case Id::k1:
+    case Id::k3:
+    case Id::k4:
+      event.client_name = NextToken(line);
+      break;
+    case Id::k2:
+      event.client_name = NextToken(line);
+      event.table_id = ParseInt(NextToken(line));
+      break;
+    default:
+      throw std::invalid_argument("Invalid incoming id");
+  }
+
+  if (event.client_name.empty())
+    throw std::invalid_argument("Invalid event param");
+
+  event.id = static_cast<Id>(event_id);
+
+  return event;
+}
+
+}  // namespace cybercafe_monitoring_system
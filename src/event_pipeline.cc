@@ -0,0 +1,237 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Event handling pipelined over a parsing, a handling and a printing thread
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/event_pipeline.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "include/event_line_parser.h"
+#include "include/spsc_queue.h"
+
+namespace {
+
+using cybercafe_monitoring_system::CybercafeMonitoringSystem;
+using cybercafe_monitoring_system::OutputSink;
+using cybercafe_monitoring_system::ParsedEventLine;
+using cybercafe_monitoring_system::SpscQueue;
+
+// Parsed lines of the text in their order
+struct ParsedBlock {
+  std::vector<ParsedEventLine> events;
+
+  // Line of every event, for error reporting
+  std::vector<std::string_view> lines;
+
+  // The last event is earlier than the one before it
+  bool order_violated = false;
+
+  // Error of the line after the events
+  std::exception_ptr error;
+
+  std::string_view error_line;
+
+  // Nothing comes after this block
+  bool last = false;
+
+  inline void Clear() {
+    events.clear();
+    lines.clear();
+    order_violated = false;
+    error = nullptr;
+    error_line = {};
+    last = false;
+  }
+};
+
+struct OutputBlock {
+  CybercafeMonitoringSystem::OutputRecords records;
+
+  bool last = false;
+};
+
+// Full blocks go forward through one queue, empty ones come back through the
+// other. The free queue starts with every block, so neither queue overflows
+template <typename Block>
+class BlockChannel final {
+ public:
+  explicit BlockChannel(size_t blocks_count)
+      : full_(blocks_count), free_(blocks_count) {
+    for (size_t i = 0; i != blocks_count; ++i) free_.Push(Block{});
+  }
+
+  inline Block TakeFree() { return free_.Pop(); }
+
+  inline void SendFull(Block block) { full_.Push(std::move(block)); }
+
+  inline Block TakeFull() { return full_.Pop(); }
+
+  inline void Release(Block block) { free_.Push(std::move(block)); }
+
+ private:
+  SpscQueue<Block> full_;
+
+  SpscQueue<Block> free_;
+};
+
+// Parses the lines into blocks and checks their order until the end of the
+// text, an incorrect line or a stop request
+void ParseLines(std::string_view text, size_t block_size,
+                const std::atomic<bool>& stop,
+                BlockChannel<ParsedBlock>& parsed) {
+  std::optional<int32_t> previous_event_time;
+
+  for (bool last = false; not last;) {
+    ParsedBlock block = parsed.TakeFree();
+    block.Clear();
+
+    while (block.events.size() != block_size and not text.empty()) {
+      const std::string_view line =
+          cybercafe_monitoring_system::NextLine(text);
+
+      try {
+        block.events.push_back(
+            cybercafe_monitoring_system::ParseEventLine(line));
+      } catch (...) {
+        block.error = std::current_exception();
+        block.error_line = line;
+        break;
+      }
+      block.lines.push_back(line);
+
+      const auto minutes = static_cast<int32_t>(
+          block.events.back().time.time_since_epoch().count());
+      if (previous_event_time and minutes < *previous_event_time) {
+        block.order_violated = true;
+        break;
+      }
+      previous_event_time = minutes;
+    }
+
+    last = block.error or block.order_violated or text.empty() or
+           stop.load(std::memory_order_relaxed);
+    block.last = last;
+    parsed.SendFull(std::move(block));
+  }
+}
+
+// Prints the output blocks until the last one. After an output error the
+// blocks are only released, so the handling thread never waits forever
+void PrintBlocks(OutputSink& output, BlockChannel<OutputBlock>& formatted,
+                 std::exception_ptr& error) {
+  for (bool last = false; not last;) {
+    OutputBlock block = formatted.TakeFull();
+    last = block.last;
+
+    if (not error) {
+      try {
+        CybercafeMonitoringSystem::PrintOutputRecords(block.records, output);
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+
+    block.records.Clear();
+    formatted.Release(std::move(block));
+  }
+}
+
+}  // namespace
+
+namespace cybercafe_monitoring_system {
+
+// Handles the event lines of the text with the same output as one thread
+// handling them in order, on a parsing, a handling and a printing thread
+EventPipelineResult HandleEventsPipelined(
+    CybercafeMonitoringSystem& system, std::string_view text,
+    std::string_view& file_line, OutputSink& output,
+    const EventPipelineOptions& options) {
+  const size_t block_size = std::max<size_t>(options.block_size, 1);
+  const size_t blocks_count = std::max<size_t>(options.blocks_in_flight, 2);
+
+  BlockChannel<ParsedBlock> parsed(blocks_count);
+  BlockChannel<OutputBlock> formatted(blocks_count);
+  std::atomic<bool> stop = false;
+  std::exception_ptr handling_error, output_error;
+  EventPipelineResult result;
+
+  {
+    std::jthread parser(ParseLines, text, block_size, std::cref(stop),
+                        std::ref(parsed));
+    std::jthread printer(PrintBlocks, std::ref(output), std::ref(formatted),
+                         std::ref(output_error));
+
+    OutputBlock current = formatted.TakeFree();
+    system.SetOutputRecords(&current.records);
+    auto send_output = [&](bool last) {
+      current.last = last;
+      formatted.SendFull(std::move(current));
+      if (last) return;
+
+      current = formatted.TakeFree();
+      system.SetOutputRecords(&current.records);
+    };
+
+    // After an error the parsed blocks are only released, until the last one
+    for (bool last = false; not last;) {
+      ParsedBlock block = parsed.TakeFull();
+      last = block.last;
+
+      const size_t events_count = block.events.size();
+      for (size_t i = 0; i != events_count and not handling_error; ++i) {
+        file_line = block.lines[i];
+        try {
+          const ParsedEventLine& event = block.events[i];
+          const auto record = system.MakeEventRecord(
+              event.time, event.id, event.client_name, event.table_id);
+
+          // Printed like the single-threaded order check does
+          if (block.order_violated and i + 1 == events_count) {
+            system.PrintEventRecord(record);
+            result.order_violated = true;
+            break;
+          }
+
+          system.Handle(record);
+          ++result.events;
+        } catch (...) {
+          handling_error = std::current_exception();
+          stop.store(true, std::memory_order_relaxed);
+        }
+
+        if (current.records.records.size() >= block_size) send_output(false);
+      }
+
+      if (block.error and not handling_error and not result.order_violated) {
+        file_line = block.error_line;
+        handling_error = block.error;
+      }
+      parsed.Release(std::move(block));
+    }
+
+    system.SetOutputRecords(nullptr);
+    send_output(true);
+  }
+
+  if (handling_error) std::rethrow_exception(handling_error);
+  if (output_error) std::rethrow_exception(output_error);
+  return result;
+}
+
+}  // namespace cybercafe_monitoring_system
@@ -0,0 +1,46 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Fixed size latency histogram
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/latency_histogram.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+namespace cybercafe_monitoring_system {
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+  for (size_t i = 0; i != kBucketsCount; ++i) counts_[i] += other.counts_[i];
+  total_count_ += other.total_count_;
+}
+
+// Upper bound of the bucket holding the given share of the recorded values
+std::chrono::nanoseconds LatencyHistogram::Percentile(double share) const {
+  if (total_count_ == 0) return std::chrono::nanoseconds{0};
+
+  const auto rank = std::max<uint64_t>(
+      static_cast<uint64_t>(std::ceil(std::clamp(share, 0.0, 1.0) *
+                                      static_cast<double>(total_count_))),
+      1);
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i != kBucketsCount; ++i) {
+    seen += counts_[i];
+    if (seen >= rank)
+      return std::chrono::nanoseconds{
+          static_cast<int64_t>(BucketUpperBound(i))};
+  }
+
+  return std::chrono::nanoseconds{
+      static_cast<int64_t>(BucketUpperBound(kBucketsCount - 1))};
+}
+
+}  // namespace cybercafe_monitoring_system
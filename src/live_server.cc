@@ -0,0 +1,401 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Real-time event ingestion from terminals over a local socket
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/live_server.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <format>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "include/event_line_parser.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace {
+
+#ifdef __linux__
+
+using cybercafe_monitoring_system::CybercafeMonitoringSystem;
+using cybercafe_monitoring_system::TimePoint;
+
+// Minutes since the local midnight
+TimePoint LocalTimeOfDay() {
+  const std::time_t now = std::time(nullptr);
+  std::tm local_time{};
+  localtime_r(&now, &local_time);
+  return TimePoint(
+      std::chrono::minutes{local_time.tm_hour * 60 + local_time.tm_min});
+}
+
+// Reads "[HH:MM] <id> <client name> [table]". A line without the time gets
+// the given one
+cybercafe_monitoring_system::ParsedEventLine ParseLiveLine(
+    std::string_view line, TimePoint now) {
+  using cybercafe_monitoring_system::NextToken;
+  using cybercafe_monitoring_system::ParseInt;
+  using Id = CybercafeMonitoringSystem::Event::Id;
+
+  std::string_view line_rest = line;
+  if (NextToken(line_rest).find(':') != std::string_view::npos)
+    return cybercafe_monitoring_system::ParseEventLine(line);
+
+  line_rest = line;
+  cybercafe_monitoring_system::ParsedEventLine parsed;
+  parsed.time = now;
+  parsed.id = static_cast<Id>(ParseInt(NextToken(line_rest)));
+  parsed.client_name = NextToken(line_rest);
+  if (parsed.client_name.empty())
+    throw std::invalid_argument("Missing client name");
+
+  if (parsed.id == Id::k2) parsed.table_id = ParseInt(NextToken(line_rest));
+
+  if (not NextToken(line_rest).empty())
+    throw std::invalid_argument("Unexpected event param");
+
+  return parsed;
+}
+
+[[noreturn]] void ThrowSystemError(std::string_view what) {
+  throw std::runtime_error(std::format("{}: {}", what, std::strerror(errno)));
+}
+
+#endif
+
+}  // namespace
+
+namespace cybercafe_monitoring_system {
+
+// Prints "events <handled> rejected <count> paused <count> latency p50 <us>
+// p99 <us>"
+void PrintLiveStats(const LiveStats& stats, OutputSink& output) {
+  using std::chrono::microseconds;
+
+  output.Print(
+      "events {} rejected {} paused {} latency p50 {}us p99 {}us\n",
+      stats.handled_events, stats.rejected_events, stats.paused_connections,
+      std::chrono::ceil<microseconds>(stats.latency.Percentile(0.50)).count(),
+      std::chrono::ceil<microseconds>(stats.latency.Percentile(0.99)).count());
+}
+
+#ifdef __linux__
+
+// Binds the socket, replacing a stale one
+LiveServer::LiveServer(CybercafeMonitoringSystem& system,
+                       const LiveServerOptions& options)
+    : system_(system), options_(options) {
+  if (not options_.clock) options_.clock = LocalTimeOfDay;
+  options_.max_lines_per_wakeup =
+      std::max<size_t>(options_.max_lines_per_wakeup, 1);
+
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  const std::string socket_path = options_.socket_path.string();
+  if (socket_path.empty() or socket_path.size() >= sizeof(address.sun_path))
+    throw std::runtime_error(
+        std::format("Invalid socket path: {}", socket_path));
+  std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+  if (std::filesystem::is_socket(options_.socket_path))
+    std::filesystem::remove(options_.socket_path);
+
+  listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  stop_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+  if (listen_fd_ < 0 or stop_fd_ < 0 or epoll_fd_ < 0) {
+    CloseDescriptors();
+    ThrowSystemError("Cannot create live server");
+  }
+
+  if (::bind(listen_fd_, reinterpret_cast<const sockaddr*>(&address),
+             sizeof(address)) != 0 or
+      ::listen(listen_fd_, SOMAXCONN) != 0) {
+    CloseDescriptors();
+    ThrowSystemError(std::format("Cannot listen on {}", socket_path));
+  }
+
+  for (int fd : {listen_fd_, stop_fd_}) {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+  }
+}
+
+LiveServer::~LiveServer() {
+  for (auto& [fd, connection] : connections_) ::close(fd);
+  CloseDescriptors();
+
+  std::error_code error;
+  if (std::filesystem::is_socket(options_.socket_path, error))
+    std::filesystem::remove(options_.socket_path, error);
+}
+
+// Polls until Stop is called, then closes an open day
+void LiveServer::Run() {
+  // The clock is checked at least once a second to open and close in time
+  while (Poll(std::chrono::seconds{1})) {
+  }
+
+  if (day_open_) {
+    system_.EndWorkDayTrigger();
+    day_open_ = false;
+  }
+}
+
+// Waits for input at most max_wait, handles it and flushes the output
+bool LiveServer::Poll(std::chrono::milliseconds max_wait) {
+  if (stopped_.load(std::memory_order_relaxed)) return false;
+
+  OpenOrCloseDay();
+
+  // Lines left over by the budget are handled without waiting
+  constexpr int kMaxEvents = 64;
+  epoll_event events[kMaxEvents];
+  const int ready = ::epoll_wait(
+      epoll_fd_, events, kMaxEvents,
+      pending_lines_ ? 0 : static_cast<int>(max_wait.count()));
+  if (ready < 0 and errno != EINTR) ThrowSystemError("Cannot poll");
+
+  for (int i = 0; i < ready; ++i) {
+    const int fd = events[i].data.fd;
+    if (fd == stop_fd_) {
+      stopped_.store(true, std::memory_order_relaxed);
+    } else if (fd == listen_fd_) {
+      AcceptConnections();
+    } else if (auto it = connections_.find(fd); it != connections_.end()) {
+      ReadConnection(it->second);
+    }
+  }
+
+  // The time could pass the opening or the closing while waiting
+  OpenOrCloseDay();
+
+  size_t budget = options_.max_lines_per_wakeup;
+  pending_lines_ = false;
+  std::vector<int> finished;
+  for (auto& [fd, connection] : connections_) {
+    const bool lines_left = HandleLines(connection, budget);
+    UpdateInterest(connection, lines_left);
+    pending_lines_ = pending_lines_ or lines_left;
+
+    if (connection.peer_closed and connection.buffer.empty())
+      finished.push_back(fd);
+  }
+  for (int fd : finished) CloseConnection(fd);
+
+  system_.GetOutputSink().Flush();
+  const auto flushed = SteadyClock::now();
+  for (auto received : unflushed_) stats_.latency.Record(flushed - received);
+  unflushed_.clear();
+
+  return not stopped_.load(std::memory_order_relaxed);
+}
+
+// Safe to call from another thread or a signal handler
+void LiveServer::Stop() {
+  stopped_.store(true, std::memory_order_relaxed);
+
+  const uint64_t one = 1;
+  [[maybe_unused]] auto written = ::write(stop_fd_, &one, sizeof(one));
+}
+
+void LiveServer::OpenOrCloseDay() {
+  const bool working = system_.IsWorking(options_.clock());
+  if (working == day_open_) return;
+
+  if (working)
+    system_.StartWorkDayTrigger();
+  else
+    system_.EndWorkDayTrigger();
+
+  // Event times of a new day start over
+  day_open_ = working;
+  previous_event_time_.reset();
+}
+
+void LiveServer::AcceptConnections() {
+  for (;;) {
+    const int fd = ::accept4(listen_fd_, nullptr, nullptr,
+                             SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) return;
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+      ::close(fd);
+      continue;
+    }
+
+    connections_[fd].fd = fd;
+    ++stats_.connections;
+  }
+}
+
+// Reads what fits into the connection buffer
+void LiveServer::ReadConnection(Connection& connection) {
+  const size_t used = connection.buffer.size();
+  const size_t room = options_.max_connection_buffer - used;
+  if (room == 0 or connection.peer_closed) return;
+
+  connection.buffer.resize(used + room);
+  const ssize_t read_bytes =
+      ::read(connection.fd, connection.buffer.data() + used, room);
+  connection.buffer.resize(used + std::max<ssize_t>(read_bytes, 0));
+
+  if (read_bytes > 0)
+    connection.chunks.emplace_back(connection.buffer.size(),
+                                   SteadyClock::now());
+  else if (read_bytes == 0 or (errno != EAGAIN and errno != EINTR))
+    connection.peer_closed = true;
+}
+
+// Handles complete lines while the budget lasts
+bool LiveServer::HandleLines(Connection& connection, size_t& budget) {
+  auto lines_left = [&connection] {
+    return connection.buffer.find('\n') != std::string::npos or
+           (connection.peer_closed and not connection.buffer.empty());
+  };
+
+  // Used up by the connections before this one, the lines wait for the next
+  // wakeup whether the buffer is full or not
+  if (budget == 0) return lines_left();
+
+  std::string_view text = connection.buffer;
+  size_t consumed = 0;
+  auto chunk = connection.chunks.begin();
+
+  while (budget != 0) {
+    size_t line_end = text.find('\n', consumed);
+    if (line_end == std::string_view::npos) {
+      // The last line of a closed connection may have no line break
+      if (not connection.peer_closed or consumed == text.size()) break;
+      line_end = text.size();
+    }
+
+    while (chunk->first <= line_end and
+           std::next(chunk) != connection.chunks.end())
+      ++chunk;
+
+    std::string_view line = text.substr(consumed, line_end - consumed);
+    if (not line.empty() and line.back() == '\r') line.remove_suffix(1);
+    consumed = std::min(line_end + 1, text.size());
+
+    if (line.empty()) continue;
+    --budget;
+    if (HandleLine(line)) unflushed_.push_back(chunk->second);
+  }
+
+  // A line longer than the whole buffer can never be handled
+  if (consumed == 0 and
+      connection.buffer.size() == options_.max_connection_buffer and
+      text.find('\n') == std::string_view::npos) {
+    ++stats_.rejected_events;
+    connection.buffer.clear();
+    connection.chunks.clear();
+    connection.peer_closed = true;
+    return false;
+  }
+
+  connection.buffer.erase(0, consumed);
+  std::erase_if(connection.chunks,
+                [consumed](const auto& c) { return c.first <= consumed; });
+  for (auto& [end, received] : connection.chunks) end -= consumed;
+
+  return lines_left();
+}
+
+// Returns false if the line is rejected
+bool LiveServer::HandleLine(std::string_view line) {
+  try {
+    auto parsed = ParseLiveLine(line, options_.clock());
+    auto event = system_.MakeEventRecord(parsed.time, parsed.id,
+                                         parsed.client_name, parsed.table_id);
+
+    if (previous_event_time_ and event.minutes < *previous_event_time_) {
+      ++stats_.rejected_events;
+      return false;
+    }
+    previous_event_time_ = event.minutes;
+
+    system_.Handle(event);
+    ++stats_.handled_events;
+    return true;
+  } catch (const std::invalid_argument&) {
+  } catch (const std::out_of_range&) {
+  }
+
+  ++stats_.rejected_events;
+  return false;
+}
+
+// Stops reading the connection while it has lines left by the budget
+void LiveServer::UpdateInterest(Connection& connection, bool lines_left) {
+  if (lines_left == connection.paused or connection.peer_closed) return;
+
+  epoll_event event{};
+  event.events = lines_left ? 0u : static_cast<uint32_t>(EPOLLIN);
+  event.data.fd = connection.fd;
+  ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection.fd, &event);
+
+  connection.paused = lines_left;
+  if (lines_left) ++stats_.paused_connections;
+}
+
+void LiveServer::CloseConnection(int fd) {
+  ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  ::close(fd);
+  connections_.erase(fd);
+}
+
+void LiveServer::CloseDescriptors() {
+  for (int* fd : {&epoll_fd_, &stop_fd_, &listen_fd_})
+    if (*fd >= 0) ::close(std::exchange(*fd, -1));
+}
+
+#else
+
+LiveServer::LiveServer(CybercafeMonitoringSystem& system,
+                       const LiveServerOptions& options)
+    : system_(system), options_(options) {
+  throw std::runtime_error("The live mode is supported on Linux only");
+}
+
+LiveServer::~LiveServer() = default;
+
+void LiveServer::Run() {}
+
+bool LiveServer::Poll(std::chrono::milliseconds) { return false; }
+
+void LiveServer::Stop() {}
+
+#endif
+
+}  // namespace cybercafe_monitoring_system
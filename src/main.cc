@@ -8,44 +8,283 @@
 // copyright holder. For permission requests, please contact:
 // mag1str.kram@gmail.com
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <span>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
+#include "include/batch_runner.h"
+#include "include/cybercafe_monitoring_system.h"
+#include "include/event_line_parser.h"
+#include "include/output_sink.h"
 #include "include/read_input_data.h"
 
-int main(int argc, char* argv[]) {
-  if (argc != 2) {
-    std::cerr << "Usage: <target filename> <filename of file for reading the "
-                 "input data>\n";
-    return 1;
-  }
+namespace {
+
+// Resolves the input file: as given (absolute, relative to the working
+// directory, a FIFO) or, for compatibility, relative to the project tests/
+std::filesystem::path ResolveInputPath(std::string_view filename) {
+  std::filesystem::path file_path(filename);
+  if (std::filesystem::exists(file_path)) return file_path;
 
   std::filesystem::path current_path = std::filesystem::current_path();
 
-  while (current_path.has_parent_path()) {
+  while (current_path.has_parent_path() and
+         current_path != current_path.root_path()) {
     if (current_path.filename() == "cybercafe-monitoring-system") {
       break;
     }
     current_path = current_path.parent_path();
   }
 
-  std::filesystem::path file_path = current_path / "tests" / argv[1];
+  return current_path / "tests" / file_path;
+}
 
-  if (!std::filesystem::exists(file_path)) {
-    std::cerr << "File not found: " << file_path << std::endl;
-    return 1;
+// Processes every input into its own file in options.output_dir and prints
+// the throughput summary
+int RunBatchMode(
+    std::span<char*> arguments,
+    const cybercafe_monitoring_system_test::BatchOptions& options) {
+  std::vector<std::string_view> inputs_arguments(arguments.begin(),
+                                                 arguments.end());
+  auto inputs =
+      cybercafe_monitoring_system_test::CollectBatchInputs(inputs_arguments);
+
+  auto result = cybercafe_monitoring_system_test::RunBatch(inputs, options);
+
+  cybercafe_monitoring_system::StreamOutputSink output(std::cout);
+  cybercafe_monitoring_system_test::PrintBatchSummary(result, output);
+
+  return result.GetFailedCount() == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  using cybercafe_monitoring_system_test::InputMode;
+
+  InputMode mode = InputMode::kBuffered;
+  bool use_mapped_reader = false;
+  bool pipelined = false;
+  bool parallel = false;
+  bool binary = false;
+  std::filesystem::path binary_output_path, text_output_path;
+  std::vector<cybercafe_monitoring_system::TimePoint> state_times;
+  bool batch = false;
+  std::string_view live_socket_path;
+  cybercafe_monitoring_system_test::CheckpointOptions checkpoint_options;
+  cybercafe_monitoring_system_test::BatchOptions batch_options;
+  for (; argc > 2 and std::string_view(argv[1]).starts_with("--");
+       --argc, ++argv) {
+    if (std::string_view(argv[1]) == "--stream") {
+      mode = InputMode::kStreaming;
+    } else if (std::string_view(argv[1]) == "--mmap") {
+      use_mapped_reader = true;
+    } else if (std::string_view(argv[1]) == "--pipelined") {
+      pipelined = true;
+    } else if (std::string_view(argv[1]) == "--parallel") {
+      parallel = true;
+    } else if (std::string_view(argv[1]) == "--binary") {
+      binary = true;
+    } else if (std::string_view(argv[1]) == "--to-binary" and argc > 3) {
+      binary_output_path = argv[2];
+      --argc, ++argv;
+    } else if (std::string_view(argv[1]) == "--to-text" and argc > 3) {
+      text_output_path = argv[2];
+      --argc, ++argv;
+    } else if (std::string_view(argv[1]) == "--state-at" and argc > 3) {
+      try {
+        state_times.push_back(cybercafe_monitoring_system::ParseTime(argv[2]));
+      } catch (const std::invalid_argument&) {
+        std::cerr << "Invalid time: " << argv[2] << "\n";
+        return 1;
+      }
+      --argc, ++argv;
+    } else if (std::string_view(argv[1]) == "--batch" and argc > 3) {
+      batch = true;
+      batch_options.output_dir = argv[2];
+      --argc, ++argv;
+    } else if (std::string_view(argv[1]) == "--live" and argc > 3) {
+      live_socket_path = argv[2];
+      --argc, ++argv;
+    } else if (std::string_view(argv[1]) == "--checkpoint" and argc > 3) {
+      use_mapped_reader = true;
+      checkpoint_options.path = argv[2];
+      --argc, ++argv;
+    } else if (std::string_view(argv[1]) == "--checkpoint-every" and
+               argc > 3) {
+      try {
+        const int interval_events =
+            cybercafe_monitoring_system::ParseInt(argv[2]);
+        if (interval_events <= 0)
+          throw std::invalid_argument("Non-positive checkpoint interval");
+        checkpoint_options.interval_events =
+            static_cast<uint64_t>(interval_events);
+      } catch (const std::invalid_argument&) {
+        std::cerr << "Invalid checkpoint interval: " << argv[2] << "\n";
+        return 1;
+      }
+      --argc, ++argv;
+    } else if (std::string_view(argv[1]) == "--threads" and argc > 3) {
+      try {
+        const int threads_count =
+            cybercafe_monitoring_system::ParseInt(argv[2]);
+        if (threads_count < 0)
+          throw std::invalid_argument("Negative thread count");
+        batch_options.threads_count = static_cast<size_t>(threads_count);
+      } catch (const std::invalid_argument&) {
+        std::cerr << "Invalid thread count: " << argv[2] << "\n";
+        return 1;
+      }
+      --argc, ++argv;
+    } else {
+      std::cerr << "Unknown option: " << argv[1] << "\n";
+      return 1;
+    }
   }
 
-  std::ifstream file(file_path);
-  if (!file.is_open()) {
-    std::cerr << "Cannot open file: " << argv[1];
+  if (argc != 2 and not(batch and argc > 2)) {
+    std::cerr << "Usage: <target filename> [--stream | --mmap | --pipelined] "
+                 "<filename of file for reading the input data | - for "
+                 "stdin>\n"
+                 "       <target filename> [--threads <count>] --parallel "
+                 "<filename of file for reading the input data>\n"
+                 "       <target filename> [--stream | --mmap] [--threads "
+                 "<count>] --batch <output directory> <file | directory | "
+                 "@manifest>...\n"
+                 "       <target filename> --checkpoint <checkpoint file> "
+                 "[--checkpoint-every <events>] <filename of file for "
+                 "reading the input data>\n"
+                 "       <target filename> --binary <filename of binary event "
+                 "log>\n"
+                 "       <target filename> --to-binary <binary event log> | "
+                 "--to-text <text file> <filename of file to convert>\n"
+                 "       <target filename> --state-at <HH:MM>... <filename of "
+                 "file for reading the input data>\n"
+                 "       <target filename> --live <socket path> <filename of "
+                 "file with the first three lines of the input data>\n";
     return 1;
   }
 
   try {
-    cybercafe_monitoring_system_test::ProcessingInputData(file);
+    if (batch) {
+      batch_options.mode = mode;
+      batch_options.use_mapped_reader = use_mapped_reader;
+      return RunBatchMode(std::span<char*>(argv + 1, argv + argc),
+                          batch_options);
+    }
+
+    if (not live_socket_path.empty()) {
+      std::ifstream config(ResolveInputPath(argv[1]));
+      if (!config.is_open()) {
+        std::cerr << "Cannot open file: " << argv[1];
+        return 1;
+      }
+
+      cybercafe_monitoring_system_test::ProcessingLiveInputData(
+          config, live_socket_path);
+      return 0;
+    }
+
+    if (std::string_view(argv[1]) == "-") {
+      cybercafe_monitoring_system_test::ProcessingInputData(
+          std::cin, InputMode::kStreaming);
+      return 0;
+    }
+
+    std::filesystem::path file_path = ResolveInputPath(argv[1]);
+
+    if (!std::filesystem::exists(file_path)) {
+      std::cerr << "File not found: " << file_path << std::endl;
+      return 1;
+    }
+
+    if (not binary_output_path.empty()) {
+      cybercafe_monitoring_system_test::ConvertTextToBinaryLog(
+          file_path, binary_output_path);
+      return 0;
+    }
+
+    if (not text_output_path.empty()) {
+      cybercafe_monitoring_system_test::ConvertBinaryToTextLog(
+          file_path, text_output_path);
+      return 0;
+    }
+
+    if (not state_times.empty()) {
+      cybercafe_monitoring_system::StreamOutputSink output(std::cout);
+      cybercafe_monitoring_system_test::ProcessingStateQueries(
+          file_path, state_times, output);
+      return 0;
+    }
+
+    if (binary) {
+      cybercafe_monitoring_system::StreamOutputSink output(std::cout);
+      cybercafe_monitoring_system_test::ProcessingBinaryInputData(file_path,
+                                                                  output);
+      return 0;
+    }
+
+    if (not checkpoint_options.path.empty()) {
+      if (not std::filesystem::is_regular_file(file_path)) {
+        std::cerr << "Checkpoints need a regular file: " << argv[1];
+        return 1;
+      }
+
+      cybercafe_monitoring_system::StreamOutputSink output(std::cout);
+      cybercafe_monitoring_system_test::ProcessingMappedInputData(
+          file_path, output, checkpoint_options);
+      return 0;
+    }
+
+    if (pipelined) {
+      if (not std::filesystem::is_regular_file(file_path)) {
+        std::cerr << "Pipelining needs a regular file: " << argv[1];
+        return 1;
+      }
+
+      cybercafe_monitoring_system::StreamOutputSink output(std::cout);
+      cybercafe_monitoring_system_test::ProcessingPipelinedInputData(file_path,
+                                                                     output);
+      return 0;
+    }
+
+    if (parallel) {
+      if (not std::filesystem::is_regular_file(file_path)) {
+        std::cerr << "Parallel parsing needs a regular file: " << argv[1];
+        return 1;
+      }
+
+      cybercafe_monitoring_system::StreamOutputSink output(std::cout);
+      cybercafe_monitoring_system_test::ProcessingParallelInputData(
+          file_path, output, batch_options.threads_count);
+      return 0;
+    }
+
+    if (use_mapped_reader and std::filesystem::is_regular_file(file_path)) {
+      cybercafe_monitoring_system_test::ProcessingMappedInputData(file_path);
+      return 0;
+    }
+
+    // A pipe has no end until the writer closes it, so it is never buffered
+    if (std::filesystem::is_fifo(file_path)) mode = InputMode::kStreaming;
+
+    std::ifstream file(file_path);
+    if (!file.is_open()) {
+      std::cerr << "Cannot open file: " << argv[1];
+      return 1;
+    }
+
+    cybercafe_monitoring_system_test::ProcessingInputData(file, mode);
+  } catch (const cybercafe_monitoring_system_test::EventsOrderViolation&) {
+    // The offending event is already printed
+    return 1;
   } catch (const std::runtime_error& e) {
     std::cerr << e.what();
     return 1;
@@ -0,0 +1,162 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Read-only memory mapped file
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/mapped_file.h"
+
+#include <filesystem>
+#include <format>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cybercafe_monitoring_system {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& file_path) {
+  HANDLE file = CreateFileW(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    throw std::runtime_error(
+        std::format("Cannot open file: {}", file_path.string()));
+  file_handle_ = file;
+
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size)) {
+    Unmap();
+    throw std::runtime_error(
+        std::format("Cannot get file size: {}", file_path.string()));
+  }
+
+  size_ = static_cast<size_t>(file_size.QuadPart);
+  if (size_ == 0) return;
+
+  HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0,
+                                      nullptr);
+  if (mapping == nullptr) {
+    Unmap();
+    throw std::runtime_error(
+        std::format("Cannot map file: {}", file_path.string()));
+  }
+  mapping_handle_ = mapping;
+
+  data_ = static_cast<const char*>(
+      MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (data_ == nullptr) {
+    Unmap();
+    throw std::runtime_error(
+        std::format("Cannot map file: {}", file_path.string()));
+  }
+}
+
+void MappedFile::Unmap() noexcept {
+  if (data_ != nullptr) UnmapViewOfFile(data_);
+  if (mapping_handle_ != nullptr) CloseHandle(mapping_handle_);
+  if (file_handle_ != nullptr) CloseHandle(file_handle_);
+
+  data_ = nullptr;
+  size_ = 0;
+  mapping_handle_ = nullptr;
+  file_handle_ = nullptr;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      file_handle_(std::exchange(other.file_handle_, nullptr)),
+      mapping_handle_(std::exchange(other.mapping_handle_, nullptr)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    Unmap();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    file_handle_ = std::exchange(other.file_handle_, nullptr);
+    mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+  }
+  return *this;
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& file_path) {
+  int fd = ::open(file_path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error(
+        std::format("Cannot open file: {}", file_path.string()));
+
+  struct stat file_stat;
+  if (::fstat(fd, &file_stat) != 0) {
+    ::close(fd);
+    throw std::runtime_error(
+        std::format("Cannot get file size: {}", file_path.string()));
+  }
+
+  size_ = static_cast<size_t>(file_stat.st_size);
+  if (size_ == 0) {
+    ::close(fd);
+    return;
+  }
+
+  void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file
+  ::close(fd);
+
+  if (data == MAP_FAILED) {
+    size_ = 0;
+    throw std::runtime_error(
+        std::format("Cannot map file: {}", file_path.string()));
+  }
+
+  ::madvise(data, size_, MADV_SEQUENTIAL);
+
+  data_ = static_cast<const char*>(data);
+}
+
+void MappedFile::Unmap() noexcept {
+  if (data_ != nullptr) ::munmap(const_cast<char*>(data_), size_);
+
+  data_ = nullptr;
+  size_ = 0;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    Unmap();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+#endif
+
+MappedFile::~MappedFile() { Unmap(); }
+
+}  // namespace cybercafe_monitoring_system
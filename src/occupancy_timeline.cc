@@ -0,0 +1,90 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Per-minute occupancy of the cybercafe during the day
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/occupancy_timeline.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+
+namespace cybercafe_monitoring_system {
+
+MinuteSeries::MinuteSeries()
+    : differences_(kMinutesPerDay),
+      prefix_sums_(kMinutesPerDay + 1),
+      maxima_(kLevels * kMinutesPerDay) {}
+
+// Zeroes the counts without reallocating
+void MinuteSeries::Reset() {
+  std::ranges::fill(differences_, 0);
+  finalized_ = false;
+}
+
+// Count during the minute
+int32_t MinuteSeries::GetAt(int32_t minute) const {
+  CheckRange(minute, minute + 1);
+  Finalize();
+  return maxima_[static_cast<size_t>(minute)];
+}
+
+// Average count over minutes [from, to)
+double MinuteSeries::GetAverage(int32_t from, int32_t to) const {
+  CheckRange(from, to);
+  Finalize();
+  return static_cast<double>(prefix_sums_[static_cast<size_t>(to)] -
+                             prefix_sums_[static_cast<size_t>(from)]) /
+         (to - from);
+}
+
+// Largest count over minutes [from, to), as the larger of two overlapping
+// ranges of the same power of two length
+int32_t MinuteSeries::GetPeak(int32_t from, int32_t to) const {
+  CheckRange(from, to);
+  Finalize();
+
+  const auto level =
+      static_cast<size_t>(std::bit_width(static_cast<uint32_t>(to - from)) - 1);
+  const size_t row = level * kMinutesPerDay;
+  return std::max(maxima_[row + static_cast<size_t>(from)],
+                  maxima_[row + static_cast<size_t>(to - (1 << level))]);
+}
+
+void MinuteSeries::Finalize() const {
+  if (finalized_) return;
+
+  // Level 0 of the maxima holds the counts themselves
+  int32_t count = 0;
+  for (size_t minute = 0; minute != kMinutesPerDay; ++minute) {
+    count += differences_[minute];
+    maxima_[minute] = count;
+    prefix_sums_[minute + 1] = prefix_sums_[minute] + count;
+  }
+
+  for (size_t level = 1; level != kLevels; ++level) {
+    const size_t half = size_t{1} << (level - 1);
+    const int32_t* previous = maxima_.data() + (level - 1) * kMinutesPerDay;
+    int32_t* current = maxima_.data() + level * kMinutesPerDay;
+    for (size_t minute = 0; minute + 2 * half <= kMinutesPerDay; ++minute)
+      current[minute] = std::max(previous[minute], previous[minute + half]);
+  }
+
+  finalized_ = true;
+}
+
+void MinuteSeries::CheckRange(int32_t from, int32_t to) const {
+  if (from < 0 or from >= to or to > kMinutesPerDay)
+    throw std::invalid_argument(
+        std::format("Incorrect minutes range: [{}, {})", from, to));
+}
+
+}  // namespace cybercafe_monitoring_system
@@ -0,0 +1,183 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Buffered output destinations of the cybercafe monitoring system
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/output_sink.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// The mapped output file grows by at least this many bytes at once
+constexpr size_t kMinMappedFileGrowth = size_t{1} << 20;
+
+std::FILE* OpenForWriting(const std::filesystem::path& file_path) {
+#ifdef _WIN32
+  std::FILE* file = _wfopen(file_path.c_str(), L"wb");
+#else
+  std::FILE* file = std::fopen(file_path.c_str(), "wb");
+#endif
+  if (file == nullptr)
+    throw std::runtime_error(
+        std::format("Cannot open output file: {}", file_path.string()));
+
+  // Text is already collected in large blocks, a second buffer only copies it
+  std::setvbuf(file, nullptr, _IONBF, 0);
+
+  return file;
+}
+
+void WriteToFile(std::FILE* file, std::string_view data) {
+  if (std::fwrite(data.data(), 1, data.size(), file) != data.size())
+    throw std::runtime_error("Cannot write output file");
+}
+
+}  // namespace
+
+namespace cybercafe_monitoring_system {
+
+void StreamOutputSink::Consume(std::string_view data) {
+  stream_.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+void StreamOutputSink::Sync() { stream_.flush(); }
+
+FileOutputSink::FileOutputSink(const std::filesystem::path& file_path,
+                               size_t buffer_size)
+    : OutputSink(buffer_size), file_(OpenForWriting(file_path)) {}
+
+// Flushes and closes the file if Close was not called, ignoring errors
+FileOutputSink::~FileOutputSink() {
+  if (file_ == nullptr) return;
+
+  try {
+    Flush();
+  } catch (const std::runtime_error&) {
+    // The output is lost anyway, a destructor cannot report it
+  }
+  std::fclose(file_);
+}
+
+// Flushes and closes the file, throws if the output was not written
+void FileOutputSink::Close() {
+  Flush();
+
+  std::FILE* file = std::exchange(file_, nullptr);
+  if (std::fclose(file) != 0)
+    throw std::runtime_error("Cannot write output file");
+}
+
+void FileOutputSink::Consume(std::string_view data) {
+  if (file_ == nullptr) throw std::runtime_error("Output file is closed");
+  WriteToFile(file_, data);
+}
+
+void FileOutputSink::Sync() {
+  if (file_ != nullptr and std::fflush(file_) != 0)
+    throw std::runtime_error("Cannot write output file");
+}
+
+#ifdef _WIN32
+
+MappedFileOutputSink::MappedFileOutputSink(
+    const std::filesystem::path& file_path, size_t buffer_size)
+    : OutputSink(buffer_size), file_(OpenForWriting(file_path)) {}
+
+// Flushes and closes the file, ignoring errors
+MappedFileOutputSink::~MappedFileOutputSink() {
+  try {
+    Flush();
+  } catch (const std::runtime_error&) {
+    // The output is lost anyway, a destructor cannot report it
+  }
+  std::fclose(file_);
+}
+
+void MappedFileOutputSink::Consume(std::string_view data) {
+  WriteToFile(file_, data);
+}
+
+void MappedFileOutputSink::Sync() { std::fflush(file_); }
+
+#else
+
+MappedFileOutputSink::MappedFileOutputSink(
+    const std::filesystem::path& file_path, size_t buffer_size)
+    : OutputSink(buffer_size),
+      fd_(::open(file_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)) {
+  if (fd_ < 0)
+    throw std::runtime_error(
+        std::format("Cannot open output file: {}", file_path.string()));
+}
+
+// Flushes, unmaps and truncates the file, ignoring errors
+MappedFileOutputSink::~MappedFileOutputSink() {
+  try {
+    Flush();
+  } catch (const std::runtime_error&) {
+    // The output is lost anyway, a destructor cannot report it
+  }
+
+  if (data_ != nullptr) ::munmap(data_, mapped_size_);
+  // Drops the preallocated tail. A destructor has no way to report failure
+  static_cast<void>(::ftruncate(fd_, static_cast<off_t>(written_size_)) == 0);
+  ::close(fd_);
+}
+
+void MappedFileOutputSink::Consume(std::string_view data) {
+  Reserve(written_size_ + data.size());
+
+  std::memcpy(data_ + written_size_, data.data(), data.size());
+  written_size_ += data.size();
+}
+
+void MappedFileOutputSink::Sync() {
+  if (data_ != nullptr) ::msync(data_, mapped_size_, MS_ASYNC);
+}
+
+void MappedFileOutputSink::Reserve(size_t required_size) {
+  if (required_size <= mapped_size_) return;
+
+  size_t new_size =
+      std::max({required_size, mapped_size_ * 2, kMinMappedFileGrowth});
+
+  if (::ftruncate(fd_, static_cast<off_t>(new_size)) != 0)
+    throw std::runtime_error("Cannot grow output file");
+
+  if (data_ != nullptr) ::munmap(data_, mapped_size_);
+
+  void* data =
+      ::mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (data == MAP_FAILED) {
+    data_ = nullptr;
+    mapped_size_ = 0;
+    throw std::runtime_error("Cannot map output file");
+  }
+
+  data_ = static_cast<char*>(data);
+  mapped_size_ = new_size;
+}
+
+#endif
+
+}  // namespace cybercafe_monitoring_system
@@ -0,0 +1,168 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Event lines parsed in chunks on several threads
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/parallel_event_parser.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "include/client_name_validator.h"
+#include "include/work_stealing_pool.h"
+
+namespace {
+
+using cybercafe_monitoring_system::ParsedEventLine;
+
+constexpr size_t kNoChunk = static_cast<size_t>(-1);
+
+// Lines between two looks at whether an earlier chunk has failed
+constexpr size_t kStopCheckLines = 4096;
+
+// Events of one chunk of whole lines
+struct ParsedChunk {
+  std::vector<ParsedEventLine> events;
+
+  std::optional<std::string_view> incorrect_line;
+
+  // Index of the first event earlier than the one before it in this chunk
+  std::optional<size_t> order_violation;
+};
+
+inline int32_t ToMinutes(const ParsedEventLine& event) {
+  return static_cast<int32_t>(event.time.time_since_epoch().count());
+}
+
+// Splits the text after every chunk_size bytes at the end of the current line
+std::vector<std::string_view> SplitIntoChunks(std::string_view text,
+                                              size_t chunk_size) {
+  std::vector<std::string_view> chunks;
+  while (not text.empty()) {
+    size_t chunk_end = chunk_size >= text.size()
+                           ? std::string_view::npos
+                           : text.find('\n', chunk_size - 1);
+    chunk_end = chunk_end == std::string_view::npos ? text.size()
+                                                    : chunk_end + 1;
+
+    chunks.push_back(text.substr(0, chunk_end));
+    text.remove_prefix(chunk_end);
+  }
+  return chunks;
+}
+
+// Parses the lines of the chunk until its end or its first incorrect line.
+// Gives up once a chunk before it has an incorrect line, its events are of no
+// use then
+void ParseChunk(std::string_view text, size_t chunk_index,
+                std::atomic<size_t>& first_incorrect_chunk,
+                ParsedChunk& chunk) {
+  chunk.events.reserve(text.size() / 16);
+
+  for (size_t lines = 0; not text.empty(); ++lines) {
+    if (lines % kStopCheckLines == 0 and
+        first_incorrect_chunk.load(std::memory_order_relaxed) < chunk_index)
+      return;
+
+    const std::string_view line = cybercafe_monitoring_system::NextLine(text);
+    try {
+      const ParsedEventLine event =
+          cybercafe_monitoring_system::ParseEventLine(line);
+      if (not cybercafe_monitoring_system::IsClientNameValid(
+              event.client_name))
+        throw std::invalid_argument("Invalid client name");
+
+      if (not chunk.order_violation and not chunk.events.empty() and
+          ToMinutes(event) < ToMinutes(chunk.events.back()))
+        chunk.order_violation = chunk.events.size();
+      chunk.events.push_back(event);
+    } catch (const std::invalid_argument&) {
+      chunk.incorrect_line = line;
+
+      size_t first = first_incorrect_chunk.load(std::memory_order_relaxed);
+      while (chunk_index < first and
+             not first_incorrect_chunk.compare_exchange_weak(
+                 first, chunk_index, std::memory_order_relaxed)) {
+      }
+      return;
+    }
+  }
+}
+
+}  // namespace
+
+namespace cybercafe_monitoring_system {
+
+// Splits the text into chunks of whole lines, parses them on a thread pool
+// and copies them into one array, checking the order across the chunks
+ParallelParseResult ParseEventLinesParallel(
+    std::string_view text, const ParallelParseOptions& options) {
+  const std::vector<std::string_view> texts =
+      SplitIntoChunks(text, std::max<size_t>(options.chunk_size, 1));
+  std::vector<ParsedChunk> chunks(texts.size());
+  const WorkStealingPool pool(options.threads_count);
+
+  std::atomic<size_t> first_incorrect_chunk = kNoChunk;
+  pool.ForEach(texts.size(), [&](size_t i) {
+    ParseChunk(texts[i], i, first_incorrect_chunk, chunks[i]);
+  });
+
+  // Only the chunks up to the first incorrect line count
+  const size_t incorrect_chunk = first_incorrect_chunk.load();
+  const size_t chunks_count =
+      incorrect_chunk == kNoChunk ? chunks.size() : incorrect_chunk + 1;
+
+  ParallelParseResult result;
+  std::vector<size_t> offsets(chunks_count + 1, 0);
+  for (size_t i = 0; i != chunks_count; ++i)
+    offsets[i + 1] = offsets[i] + chunks[i].events.size();
+  if (chunks_count != 0)
+    result.incorrect_line = chunks[chunks_count - 1].incorrect_line;
+
+  result.events.resize(offsets.back());
+  pool.ForEach(chunks_count, [&](size_t i) {
+    std::ranges::copy(chunks[i].events, result.events.begin() + offsets[i]);
+    chunks[i].events = {};
+  });
+
+  result.order_violation = result.events.size();
+  if (result.incorrect_line) return result;
+
+  // The border of a chunk comes before the events inside it
+  for (size_t i = 0; i != chunks_count; ++i) {
+    if (i != 0 and ToMinutes(result.events[offsets[i]]) <
+            ToMinutes(result.events[offsets[i] - 1])) {
+      result.order_violation = offsets[i];
+      break;
+    }
+    if (chunks[i].order_violation) {
+      result.order_violation = offsets[i] + *chunks[i].order_violation;
+      break;
+    }
+  }
+
+  return result;
+}
+
+// The whole line of the text that contains the character
+std::string_view GetLineAround(std::string_view text, const char* character) {
+  const size_t position = static_cast<size_t>(character - text.data());
+  const size_t line_begin = text.rfind('\n', position);
+
+  text = text.substr(0, text.find('\n', position));
+  return text.substr(line_begin == std::string_view::npos ? 0
+                                                          : line_begin + 1);
+}
+
+}  // namespace cybercafe_monitoring_system
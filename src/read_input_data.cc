@@ -10,129 +10,301 @@
 
 #include "include/read_input_data.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <format>
 #include <fstream>
 #include <iostream>
-#include <memory>
+#include <istream>
+#include <numeric>
+#include <optional>
 #include <span>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "include/binary_event_log.h"
+#include "include/checkpoint.h"
+#include "include/client_name_validator.h"
 #include "include/cybercafe_monitoring_system.h"
+#include "include/event_line_parser.h"
+#include "include/event_pipeline.h"
+#include "include/live_server.h"
+#include "include/mapped_file.h"
+#include "include/output_sink.h"
+#include "include/parallel_event_parser.h"
+#include "include/replay_engine.h"
 
 namespace {
 
+using cybercafe_monitoring_system::EventLogHeader;
+using cybercafe_monitoring_system::NextLine;
+using cybercafe_monitoring_system::OutputSink;
 using cybercafe_monitoring_system::TimePoint;
-using cybercafe_monitoring_system::CybercafeMonitoringSystem::Event::Type::
-    kIncoming;
 using CybercafeMonitoringSystem =
     cybercafe_monitoring_system::CybercafeMonitoringSystem;
+using EventRecord = CybercafeMonitoringSystem::EventRecord;
 using Id = CybercafeMonitoringSystem::Event::Id;
+using ProcessingStats = cybercafe_monitoring_system_test::ProcessingStats;
 
-// Reads event body
-std::unique_ptr<CybercafeMonitoringSystem::Event> ParseEventBody(
-    std::istringstream& iss, TimePoint event_time, int event_id) {
-  switch (static_cast<Id>(event_id)) {
-    case Id::k1: {
-      std::string client_name;
-      if (!(iss >> client_name))
-        throw std::runtime_error("Invalid event param");
-
-      return std::make_unique<CybercafeMonitoringSystem::ClientArrivedEvent>(
-          event_time, client_name);
-    } break;
-    case Id::k2: {
-      int table_id;
-      std::string client_name;
-      if (!(iss >> client_name >> table_id))
-        throw std::runtime_error("Invalid event param");
-
-      return std::make_unique<CybercafeMonitoringSystem::ClientSatAtTableEvent>(
-          event_time, client_name, table_id,
-          CybercafeMonitoringSystem::Event::Type::kIncoming);
-    } break;
-    case Id::k3: {
-      std::string client_name;
-      if (!(iss >> client_name))
-        throw std::runtime_error("Invalid event param");
-
-      return std::make_unique<CybercafeMonitoringSystem::ClientWaitingEvent>(
-          event_time, client_name);
-    } break;
-    case Id::k4: {
-      std::string client_name;
-      if (!(iss >> client_name))
-        throw std::runtime_error("Invalid event param");
-
-      return std::make_unique<CybercafeMonitoringSystem::ClientLeftEvent>(
-          event_time, client_name, kIncoming);
-    } break;
-    default:
-      throw std::runtime_error(
-          std::format("Invalid incoming id: {}", event_id));
-  }
-}
-
-// Reads time in HH:MM format
-TimePoint ParseTime(std::istringstream& iss) {
-  std::string time_token;
-  if (!(iss >> time_token))
-    throw std::invalid_argument("Failed to read time token");
-
-  if (time_token.size() != 5 or time_token[2] != ':')
-    throw std::invalid_argument("Invalid time format (expected HH:MM)");
-
-  if (!std::isdigit(time_token[0]) or !std::isdigit(time_token[1]) or
-      !std::isdigit(time_token[3]) or !std::isdigit(time_token[4]))
-    throw std::invalid_argument("Time contains non-digit characters");
-
-  int hours = std::stoi(time_token.substr(0, 2)),
-      minutes = std::stoi(time_token.substr(3, 2));
-
-  if (hours < 0 or hours > 23)
-    throw std::invalid_argument("Hours out of range (0-23)");
-  else if (minutes < 0 or minutes > 59)
-    throw std::invalid_argument("Minutes out of range (0-59)");
-
-  return TimePoint(std::chrono::minutes{hours * 60 + minutes});
-}
-
-// Reads and validates CybercafeMonitoringSystem constructor arguments
-CybercafeMonitoringSystem CreateTestObject(std::ifstream& file) {
-  std::string file_line;
-  std::getline(file, file_line);
+// Adds the time since the previous lap to a phase of the stats. Does nothing
+// without stats, so the clock is not read then
+class PhaseClock final {
+ public:
+  explicit PhaseClock(ProcessingStats* stats)
+      : stats_(stats), lap_start_(stats ? Clock::now() : Clock::time_point{}) {}
+
+  inline void Lap(std::chrono::nanoseconds ProcessingStats::*phase) {
+    if (stats_ == nullptr) return;
 
-  int cybercafe_tables_count = std::stoi(file_line);
-  if (cybercafe_tables_count <= 0) throw std::runtime_error(file_line);
+    const auto now = Clock::now();
+    stats_->*phase += now - lap_start_;
+    lap_start_ = now;
+  }
+
+  inline void CountEvents(uint64_t events) {
+    if (stats_ != nullptr) stats_->events += events;
+  }
 
-  std::getline(file, file_line);
+ private:
+  using Clock = std::chrono::steady_clock;
 
-  std::istringstream iss(file_line);
-  TimePoint cybercafe_opening_time = ParseTime(iss);
-  TimePoint cybercafe_closing_time = ParseTime(iss);
+  ProcessingStats* stats_;
 
-  std::getline(file, file_line);
-  int cybercafe_pc_hourly_rate = std::stoi(file_line);
-  if (cybercafe_pc_hourly_rate <= 0) throw std::runtime_error(file_line);
+  Clock::time_point lap_start_;
+};
+
+int32_t ToMinutes(const TimePoint& time) {
+  return static_cast<int32_t>(time.time_since_epoch().count());
+}
+
+// Reads and validates CybercafeMonitoringSystem constructor arguments straight
+// from the mapped text. The line being read is kept for error reporting
+EventLogHeader ParseHeader(std::string_view& text,
+                           std::string_view& file_line) {
+  using cybercafe_monitoring_system::NextToken;
+  using cybercafe_monitoring_system::ParseInt;
+
+  EventLogHeader header;
+
+  file_line = NextLine(text);
+  std::string_view line_rest = file_line;
+  header.tables_count = ParseInt(NextToken(line_rest));
+  if (header.tables_count <= 0)
+    throw std::invalid_argument("Invalid tables count");
+
+  file_line = NextLine(text);
+  line_rest = file_line;
+  header.opening_minutes =
+      ToMinutes(cybercafe_monitoring_system::ParseTime(NextToken(line_rest)));
+  header.closing_minutes =
+      ToMinutes(cybercafe_monitoring_system::ParseTime(NextToken(line_rest)));
+
+  file_line = NextLine(text);
+  line_rest = file_line;
+  header.hourly_rate = ParseInt(NextToken(line_rest));
+  if (header.hourly_rate <= 0)
+    throw std::invalid_argument("Invalid hourly rate");
+
+  return header;
+}
 
+CybercafeMonitoringSystem CreateTestObject(const EventLogHeader& header,
+                                           OutputSink& output) {
   return CybercafeMonitoringSystem(
-      cybercafe_opening_time, cybercafe_closing_time, cybercafe_tables_count,
-      cybercafe_pc_hourly_rate);
+      TimePoint{std::chrono::minutes{header.opening_minutes}},
+      TimePoint{std::chrono::minutes{header.closing_minutes}},
+      header.tables_count, header.hourly_rate, output);
+}
+
+CybercafeMonitoringSystem CreateTestObject(std::string_view& text,
+                                           std::string_view& file_line,
+                                           OutputSink& output) {
+  return CreateTestObject(ParseHeader(text, file_line), output);
+}
+
+// Reads and validates CybercafeMonitoringSystem constructor arguments from the
+// first three lines of the stream, with the grammar of the mapped text
+CybercafeMonitoringSystem CreateTestObject(std::istream& file,
+                                           std::string& file_line,
+                                           OutputSink& output) {
+  std::string header_text;
+  for (int line = 0; line != 3 and std::getline(file, file_line); ++line)
+    (header_text += file_line) += '\n';
+
+  std::string_view text = header_text, header_line;
+  try {
+    return CreateTestObject(ParseHeader(text, header_line), output);
+  } catch (const std::invalid_argument&) {
+    file_line = header_line;
+    throw;
+  }
 }
 
-// Checks that the events are in the correct chronological order
-void ValidateEventsOrder(
-    std::span<std::unique_ptr<CybercafeMonitoringSystem::Event>> events) {
+// Prints the event that breaks the chronological order and stops processing
+[[noreturn]] void ThrowOnEventsOrderViolation(
+    const CybercafeMonitoringSystem& system, const EventRecord& event) {
+  system.PrintEventRecord(event);
+  system.GetOutputSink().Flush();
+  throw cybercafe_monitoring_system_test::EventsOrderViolation(
+      "Events are not in chronological order");
+}
+
+// Checks that every event is not earlier than the one before it, as the
+// streaming modes do
+void ValidateEventsOrder(const CybercafeMonitoringSystem& system,
+                         std::span<const EventRecord> events) {
   if (events.size() > 1) {
-    auto previous_event_time = events[0]->GetTime();
-    for (size_t i = 1, iend = events.size(); i != iend; ++i)
-      if (events[i]->GetTime() < previous_event_time) {
-        events[i]->Print();
-        std::exit(1);
-      }
+    auto previous_event_time = events[0].minutes;
+    for (size_t i = 1, iend = events.size(); i != iend; ++i) {
+      if (events[i].minutes < previous_event_time)
+        ThrowOnEventsOrderViolation(system, events[i]);
+      previous_event_time = events[i].minutes;
+    }
+  }
+}
+
+// Reads one event line with the grammar of the mapped text
+EventRecord ParseEventLine(const std::string& file_line,
+                           CybercafeMonitoringSystem& system) {
+  const auto parsed = cybercafe_monitoring_system::ParseEventLine(file_line);
+  return system.MakeEventRecord(parsed.time, parsed.id, parsed.client_name,
+                                parsed.table_id);
+}
+
+// Reads all events first, validates their order and only then handles them.
+// Events are kept as compact records in one contiguous buffer
+void ProcessBuffered(std::istream& file, std::string& file_line,
+                     OutputSink& output, ProcessingStats* stats) {
+  PhaseClock clock(stats);
+  CybercafeMonitoringSystem test_object =
+      CreateTestObject(file, file_line, output);
+  std::vector<EventRecord> test_events;
+
+  while (std::getline(file, file_line))
+    test_events.push_back(ParseEventLine(file_line, test_object));
+
+  ValidateEventsOrder(test_object, test_events);
+  clock.Lap(&ProcessingStats::read);
+
+  test_object.StartWorkDayTrigger();
+  clock.Lap(&ProcessingStats::open);
+
+  for (const auto& event : test_events) test_object.Handle(event);
+  clock.Lap(&ProcessingStats::handle);
+  clock.CountEvents(test_events.size());
+
+  test_object.EndWorkDayTrigger();
+  clock.Lap(&ProcessingStats::close);
+}
+
+// Handles every event as soon as it is read. Only the previous event time is
+// kept for the order check, so memory stays constant for any input size
+void ProcessStreaming(std::istream& file, std::string& file_line,
+                      OutputSink& output, ProcessingStats* stats) {
+  PhaseClock clock(stats);
+  CybercafeMonitoringSystem test_object =
+      CreateTestObject(file, file_line, output);
+  std::optional<int32_t> previous_event_time;
+  uint64_t events = 0;
+  clock.Lap(&ProcessingStats::read);
+
+  test_object.StartWorkDayTrigger();
+  clock.Lap(&ProcessingStats::open);
+
+  for (; std::getline(file, file_line); ++events) {
+    EventRecord event = ParseEventLine(file_line, test_object);
+
+    if (previous_event_time and event.minutes < *previous_event_time)
+      ThrowOnEventsOrderViolation(test_object, event);
+    previous_event_time = event.minutes;
+
+    test_object.Handle(event);
   }
+  clock.Lap(&ProcessingStats::handle);
+  clock.CountEvents(events);
+
+  test_object.EndWorkDayTrigger();
+  clock.Lap(&ProcessingStats::close);
+}
+
+// Prints time in HH:MM format
+void PrintMinutes(OutputSink& output, int32_t minutes) {
+  output.Print("{:02}:{:02}", minutes / 60, minutes % 60);
+}
+
+// The event of a binary log as a line of the text format. Its client is looked
+// up back in the dictionary, which is only done for an incorrect event
+std::string FormatBinaryEvent(
+    const cybercafe_monitoring_system::BinaryEventLogReader& reader,
+    std::span<const cybercafe_monitoring_system::ClientId> clients,
+    const EventRecord& event) {
+  const auto index = static_cast<uint32_t>(
+      std::ranges::find(clients, event.client) - clients.begin());
+  std::string line = std::format("{:02}:{:02} {} {}", event.minutes / 60,
+                                 event.minutes % 60, static_cast<int>(event.id),
+                                 reader.GetClientName(index));
+  if (event.id == Id::k2) line += std::format(" {}", event.table_id);
+  return line;
+}
+
+// Handles every event of the mapped text, checking their order. Calls
+// on_event after every handled event. Returns the number of events
+template <typename OnEvent>
+uint64_t HandleMappedEvents(CybercafeMonitoringSystem& system,
+                            std::string_view& text, std::string_view& file_line,
+                            std::optional<int32_t>& previous_event_time,
+                            OnEvent&& on_event) {
+  uint64_t events = 0;
+  for (; not text.empty(); ++events) {
+    file_line = NextLine(text);
+
+    auto parsed = cybercafe_monitoring_system::ParseEventLine(file_line);
+    EventRecord event = system.MakeEventRecord(
+        parsed.time, parsed.id, parsed.client_name, parsed.table_id);
+
+    if (previous_event_time and event.minutes < *previous_event_time)
+      ThrowOnEventsOrderViolation(system, event);
+    previous_event_time = event.minutes;
+
+    system.Handle(event);
+    on_event();
+  }
+
+  return events;
+}
+
+// Appends every event of the mapped text to the binary log, validating them
+// like the processing does, names and table ids included
+void WriteBinaryLog(std::string_view& text, std::string_view& file_line,
+                    int32_t tables_count,
+                    cybercafe_monitoring_system::BinaryEventLogWriter& writer) {
+  while (not text.empty()) {
+    file_line = NextLine(text);
+
+    auto parsed = cybercafe_monitoring_system::ParseEventLine(file_line);
+    if (not cybercafe_monitoring_system::IsClientNameValid(parsed.client_name))
+      throw std::invalid_argument("Invalid client name");
+    if (parsed.id == Id::k2 and
+        (parsed.table_id < 1 or parsed.table_id > tables_count))
+      throw std::invalid_argument("Incorrect table id");
+
+    writer.Append(ToMinutes(parsed.time), parsed.id, parsed.client_name,
+                  parsed.table_id);
+  }
+  writer.Finish();
+}
+
+// The live server stopped by SIGINT and SIGTERM
+std::atomic<cybercafe_monitoring_system::LiveServer*> live_server = nullptr;
+
+extern "C" void StopLiveServer(int) {
+  if (auto* server = live_server.load()) server->Stop();
 }
 
 }  // namespace
@@ -142,37 +314,390 @@ namespace cybercafe_monitoring_system_test {
 // Reading CybercafeMonitoringSystem constructor arguments and events arguments
 // from file. If some data is incorrect, returns first incorrect data line. To
 // understand the order of arguments in file, see README.md
-void ProcessingInputData(std::ifstream& file) {
+void ProcessingInputData(std::istream& file, InputMode mode) {
+  cybercafe_monitoring_system::StreamOutputSink output(std::cout);
+  ProcessingInputData(file, output, mode);
+}
+
+void ProcessingInputData(std::istream& file, OutputSink& output,
+                         InputMode mode, ProcessingStats* stats) {
   std::string file_line;
 
   try {
-    cybercafe_monitoring_system::CybercafeMonitoringSystem test_object =
-        CreateTestObject(file);
-    std::vector<std::unique_ptr<CybercafeMonitoringSystem::Event>> test_events;
+    switch (mode) {
+      case InputMode::kBuffered:
+        ProcessBuffered(file, file_line, output, stats);
+        break;
+      case InputMode::kStreaming:
+        ProcessStreaming(file, file_line, output, stats);
+        break;
+    }
+  } catch (const std::invalid_argument&) {
+    throw std::runtime_error(file_line);
+  } catch (const std::out_of_range&) {
+    throw std::runtime_error(file_line);
+  }
+}
+
+// Reading the same data from a memory mapped file. Lines are parsed in place,
+// without per-line allocations, and every event is handled right after it is
+// parsed
+void ProcessingMappedInputData(const std::filesystem::path& file_path) {
+  cybercafe_monitoring_system::StreamOutputSink output(std::cout);
+  ProcessingMappedInputData(file_path, output);
+}
+
+void ProcessingMappedInputData(const std::filesystem::path& file_path,
+                               OutputSink& output, ProcessingStats* stats) {
+  PhaseClock clock(stats);
+  cybercafe_monitoring_system::MappedFile mapped_file(file_path);
+  std::string_view text = mapped_file.View();
+  std::string_view file_line;
+
+  try {
+    CybercafeMonitoringSystem test_object =
+        CreateTestObject(text, file_line, output);
+    std::optional<int32_t> previous_event_time;
+    clock.Lap(&ProcessingStats::read);
+
+    test_object.StartWorkDayTrigger();
+    clock.Lap(&ProcessingStats::open);
 
-    while (std::getline(file, file_line)) {
-      std::istringstream iss(file_line);
+    const uint64_t events = HandleMappedEvents(
+        test_object, text, file_line, previous_event_time, [] {});
+    clock.Lap(&ProcessingStats::handle);
+    clock.CountEvents(events);
 
-      TimePoint event_time = ParseTime(iss);
+    test_object.EndWorkDayTrigger();
+    clock.Lap(&ProcessingStats::close);
+  } catch (const std::invalid_argument&) {
+    throw std::runtime_error(std::string(file_line));
+  } catch (const std::out_of_range&) {
+    throw std::runtime_error(std::string(file_line));
+  }
+}
 
-      int event_id;
-      if (!(iss >> event_id)) throw std::runtime_error(file_line);
+// The same with a checkpoint taken every options.interval_events events
+void ProcessingMappedInputData(const std::filesystem::path& file_path,
+                               OutputSink& output,
+                               const CheckpointOptions& options) {
+  using cybercafe_monitoring_system::CheckpointPosition;
+  using cybercafe_monitoring_system::ChecksumInput;
 
-      test_events.push_back(ParseEventBody(iss, event_time, event_id));
+  cybercafe_monitoring_system::MappedFile mapped_file(file_path);
+  const std::string_view input = mapped_file.View();
+  std::string_view text = input;
+  std::string_view file_line;
+
+  try {
+    CybercafeMonitoringSystem test_object =
+        CreateTestObject(text, file_line, output);
+    const auto header_size = static_cast<uint64_t>(input.size() - text.size());
+
+    // A checkpoint of another input is refused rather than applied: the
+    // whole size and the consumed bytes have to be the same
+    CheckpointPosition position;
+    position.input_size = input.size();
+    if (std::filesystem::exists(options.path)) {
+      position = cybercafe_monitoring_system::LoadCheckpoint(options.path,
+                                                             test_object);
+      if (position.input_size != input.size() or
+          position.input_offset < header_size or
+          position.input_offset > input.size() or
+          position.input_checksum !=
+              ChecksumInput(input.substr(0, position.input_offset)))
+        throw std::runtime_error("Checkpoint does not match the input");
+      text = input.substr(position.input_offset);
+    } else {
+      test_object.StartWorkDayTrigger();
     }
 
-    ValidateEventsOrder(test_events);
+    // The output is published before the checkpoint, so after a restart
+    // only the output of the events since the last checkpoint repeats. The
+    // checksum is carried on over the bytes since the previous checkpoint
+    const uint64_t interval_events =
+        std::max<uint64_t>(options.interval_events, 1);
+    HandleMappedEvents(
+        test_object, text, file_line, position.last_event_minutes, [&] {
+          if (++position.events % interval_events != 0) return;
+
+          output.Flush();
+          const uint64_t input_offset = input.size() - text.size();
+          position.input_checksum = ChecksumInput(
+              input.substr(position.input_offset,
+                            input_offset - position.input_offset),
+              position.input_checksum);
+          position.input_offset = input_offset;
+          cybercafe_monitoring_system::WriteCheckpoint(test_object, position,
+                                                       options.path);
+        });
+
+    test_object.EndWorkDayTrigger();
+    std::filesystem::remove(options.path);
+  } catch (const std::invalid_argument&) {
+    throw std::runtime_error(std::string(file_line));
+  } catch (const std::out_of_range&) {
+    throw std::runtime_error(std::string(file_line));
+  }
+}
+
+// The same as ProcessingMappedInputData with the parsing, the handling and the
+// printing of the events overlapped on three threads
+void ProcessingPipelinedInputData(const std::filesystem::path& file_path,
+                                  OutputSink& output, ProcessingStats* stats) {
+  PhaseClock clock(stats);
+  cybercafe_monitoring_system::MappedFile mapped_file(file_path);
+  std::string_view text = mapped_file.View();
+  std::string_view file_line;
+
+  try {
+    CybercafeMonitoringSystem test_object =
+        CreateTestObject(text, file_line, output);
+    clock.Lap(&ProcessingStats::read);
 
     test_object.StartWorkDayTrigger();
+    clock.Lap(&ProcessingStats::open);
+
+    const auto result = cybercafe_monitoring_system::HandleEventsPipelined(
+        test_object, text, file_line, output);
+    if (result.order_violated) {
+      output.Flush();
+      throw EventsOrderViolation("Events are not in chronological order");
+    }
+    clock.Lap(&ProcessingStats::handle);
+    clock.CountEvents(result.events);
 
-    for (auto& ev : test_events) ev->Handle(test_object);
+    test_object.EndWorkDayTrigger();
+    clock.Lap(&ProcessingStats::close);
+  } catch (const std::invalid_argument&) {
+    throw std::runtime_error(std::string(file_line));
+  } catch (const std::out_of_range&) {
+    throw std::runtime_error(std::string(file_line));
+  }
+}
+
+// Reading the data from a memory mapped file with the event lines parsed and
+// order-checked in parallel chunks before the first event is handled
+void ProcessingParallelInputData(const std::filesystem::path& file_path,
+                                 OutputSink& output, size_t threads_count,
+                                 ProcessingStats* stats) {
+  PhaseClock clock(stats);
+  cybercafe_monitoring_system::MappedFile mapped_file(file_path);
+  std::string_view text = mapped_file.View();
+  std::string_view file_line;
+
+  try {
+    CybercafeMonitoringSystem test_object =
+        CreateTestObject(text, file_line, output);
+
+    const auto parsed = cybercafe_monitoring_system::ParseEventLinesParallel(
+        text, {.threads_count = threads_count});
+    if (parsed.incorrect_line) {
+      file_line = *parsed.incorrect_line;
+      throw std::invalid_argument("Incorrect event line");
+    }
+
+    const std::span<const cybercafe_monitoring_system::ParsedEventLine>
+        events = parsed.events;
+    auto make_record = [&](size_t i) {
+      return test_object.MakeEventRecord(events[i].time, events[i].id,
+                                         events[i].client_name,
+                                         events[i].table_id);
+    };
+
+    if (parsed.order_violation != events.size())
+      ThrowOnEventsOrderViolation(test_object,
+                                  make_record(parsed.order_violation));
+    clock.Lap(&ProcessingStats::read);
+
+    test_object.StartWorkDayTrigger();
+    clock.Lap(&ProcessingStats::open);
+
+    // The line of an event is only looked up if its handling fails
+    size_t i = 0;
+    try {
+      for (; i != events.size(); ++i) test_object.Handle(make_record(i));
+    } catch (...) {
+      file_line = cybercafe_monitoring_system::GetLineAround(
+          text, events[i].client_name.data());
+      throw;
+    }
+    clock.Lap(&ProcessingStats::handle);
+    clock.CountEvents(events.size());
 
     test_object.EndWorkDayTrigger();
+    clock.Lap(&ProcessingStats::close);
   } catch (const std::invalid_argument&) {
-    throw std::runtime_error(file_line);
+    throw std::runtime_error(std::string(file_line));
   } catch (const std::out_of_range&) {
-    throw std::runtime_error(file_line);
+    throw std::runtime_error(std::string(file_line));
   }
 }
 
+// Replaying a binary event log. Blocks are decoded straight into records, so
+// no text is parsed. Events are handled as in ProcessingMappedInputData
+void ProcessingBinaryInputData(const std::filesystem::path& file_path,
+                               OutputSink& output, ProcessingStats* stats) {
+  using cybercafe_monitoring_system::ClientId;
+
+  PhaseClock clock(stats);
+  cybercafe_monitoring_system::MappedFile mapped_file(file_path);
+  cybercafe_monitoring_system::BinaryEventLogReader reader(mapped_file.View());
+  CybercafeMonitoringSystem test_object =
+      CreateTestObject(reader.GetHeader(), output);
+
+  // The dictionary is interned once, every event then refers to a client id
+  std::vector<ClientId> clients(reader.GetClientsCount());
+  for (uint32_t i = 0; i != clients.size(); ++i)
+    clients[i] = test_object
+                     .MakeEventRecord(TimePoint{}, Id::k1,
+                                      reader.GetClientName(i))
+                     .client;
+  clock.Lap(&ProcessingStats::read);
+
+  test_object.StartWorkDayTrigger();
+  clock.Lap(&ProcessingStats::open);
+
+  // An event the system rejects is reported as its line, as in the text modes
+  std::vector<EventRecord> events;
+  std::optional<int32_t> previous_event_time;
+  uint64_t events_count = 0;
+  const EventRecord* handled_event = nullptr;
+  try {
+    while (reader.NextBlock(clients, events)) {
+      for (const EventRecord& event : events) {
+        if (previous_event_time and event.minutes < *previous_event_time)
+          ThrowOnEventsOrderViolation(test_object, event);
+        previous_event_time = event.minutes;
+
+        handled_event = &event;
+        test_object.Handle(event);
+      }
+      handled_event = nullptr;
+      events_count += events.size();
+    }
+  } catch (const std::invalid_argument& e) {
+    if (handled_event == nullptr) throw std::runtime_error(e.what());
+    throw std::runtime_error(
+        FormatBinaryEvent(reader, clients, *handled_event));
+  } catch (const std::out_of_range& e) {
+    if (handled_event == nullptr) throw std::runtime_error(e.what());
+    throw std::runtime_error(
+        FormatBinaryEvent(reader, clients, *handled_event));
+  }
+  clock.Lap(&ProcessingStats::handle);
+  clock.CountEvents(events_count);
+
+  test_object.EndWorkDayTrigger();
+  clock.Lap(&ProcessingStats::close);
+}
+
+// Converts the text input format into a binary event log. Throws
+// std::runtime_error with the first incorrect line, the log is left
+// unfinished then
+void ConvertTextToBinaryLog(const std::filesystem::path& text_path,
+                            const std::filesystem::path& binary_path) {
+  cybercafe_monitoring_system::MappedFile mapped_file(text_path);
+  std::string_view text = mapped_file.View();
+  std::string_view file_line;
+
+  try {
+    const EventLogHeader header = ParseHeader(text, file_line);
+    cybercafe_monitoring_system::BinaryEventLogWriter writer(binary_path,
+                                                             header);
+    WriteBinaryLog(text, file_line, header.tables_count, writer);
+  } catch (const std::invalid_argument&) {
+    throw std::runtime_error(std::string(file_line));
+  } catch (const std::out_of_range&) {
+    throw std::runtime_error(std::string(file_line));
+  }
+}
+
+// Converts a binary event log back into the text input format
+void ConvertBinaryToTextLog(const std::filesystem::path& binary_path,
+                            const std::filesystem::path& text_path) {
+  using cybercafe_monitoring_system::ClientId;
+
+  cybercafe_monitoring_system::MappedFile mapped_file(binary_path);
+  cybercafe_monitoring_system::BinaryEventLogReader reader(mapped_file.View());
+  cybercafe_monitoring_system::FileOutputSink output(text_path);
+
+  const EventLogHeader& header = reader.GetHeader();
+  output.Print("{}\n", header.tables_count);
+  PrintMinutes(output, header.opening_minutes);
+  output.Put(' ');
+  PrintMinutes(output, header.closing_minutes);
+  output.Print("\n{}\n", header.hourly_rate);
+
+  // Records keep the dictionary indices, so names are looked up in the log
+  std::vector<ClientId> clients(reader.GetClientsCount());
+  std::iota(clients.begin(), clients.end(), ClientId{0});
+
+  std::vector<EventRecord> events;
+  while (reader.NextBlock(clients, events)) {
+    for (const EventRecord& event : events) {
+      PrintMinutes(output, event.minutes);
+      output.Print(" {} {}", static_cast<int>(event.id),
+                   reader.GetClientName(event.client));
+      if (event.id == Id::k2) output.Print(" {}", event.table_id);
+      output.Put('\n');
+    }
+  }
+  output.Close();
+}
+
+// Prints the state at every time. The events are handled once, every state
+// is then restored from the nearest checkpoint
+void ProcessingStateQueries(const std::filesystem::path& file_path,
+                            std::span<const TimePoint> times,
+                            OutputSink& output) {
+  cybercafe_monitoring_system::MappedFile mapped_file(file_path);
+  std::string_view text = mapped_file.View();
+  std::string_view file_line;
+
+  EventLogHeader header;
+  try {
+    header = ParseHeader(text, file_line);
+  } catch (const std::invalid_argument&) {
+    throw std::runtime_error(std::string(file_line));
+  } catch (const std::out_of_range&) {
+    throw std::runtime_error(std::string(file_line));
+  }
+
+  const cybercafe_monitoring_system::ReplayEngine engine(header, text);
+  for (const TimePoint& time : times)
+    engine.PrintStateAt(ToMinutes(time), output);
+}
+
+// Serves terminals on the Unix-domain socket until SIGINT or SIGTERM
+void ProcessingLiveInputData(std::istream& config,
+                             const std::filesystem::path& socket_path) {
+  cybercafe_monitoring_system::StreamOutputSink output(std::cout);
+  CybercafeMonitoringSystem test_object = [&] {
+    std::string file_line;
+    try {
+      return CreateTestObject(config, file_line, output);
+    } catch (const std::logic_error&) {
+      throw std::runtime_error("Invalid live mode configuration");
+    }
+  }();
+
+  cybercafe_monitoring_system::LiveServerOptions options;
+  options.socket_path = socket_path;
+  cybercafe_monitoring_system::LiveServer server(test_object, options);
+
+  live_server = &server;
+  auto previous_sigint = std::signal(SIGINT, StopLiveServer);
+  auto previous_sigterm = std::signal(SIGTERM, StopLiveServer);
+
+  server.Run();
+
+  std::signal(SIGINT, previous_sigint);
+  std::signal(SIGTERM, previous_sigterm);
+  live_server = nullptr;
+
+  cybercafe_monitoring_system::StreamOutputSink report(std::cerr);
+  cybercafe_monitoring_system::PrintLiveStats(server.GetStats(), report);
+}
+
 }  // namespace cybercafe_monitoring_system_test
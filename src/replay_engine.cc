@@ -0,0 +1,145 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Queries of the cybercafe state at any time of a handled day
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/replay_engine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "include/checkpoint.h"
+#include "include/event_line_parser.h"
+
+namespace {
+
+using cybercafe_monitoring_system::CybercafeMonitoringSystem;
+using cybercafe_monitoring_system::ParsedEventLine;
+
+int32_t ToMinutes(const ParsedEventLine& event) {
+  return static_cast<int32_t>(event.time.time_since_epoch().count());
+}
+
+CybercafeMonitoringSystem::EventRecord MakeRecord(
+    CybercafeMonitoringSystem& system, const ParsedEventLine& event) {
+  return system.MakeEventRecord(event.time, event.id, event.client_name,
+                                event.table_id);
+}
+
+}  // namespace
+
+namespace cybercafe_monitoring_system {
+
+// Handles the events text, which must outlive the engine. Throws
+// std::runtime_error with the first incorrect line
+ReplayEngine::ReplayEngine(const EventLogHeader& header,
+                           std::string_view events, uint64_t interval_events)
+    : header_(header), events_(events) {
+  interval_events = std::max<uint64_t>(interval_events, 1);
+
+  NullOutputSink output;
+  CybercafeMonitoringSystem system = MakeSystem(output);
+  system.StartWorkDayTrigger();
+
+  CheckpointPosition position;
+  std::string data;
+  CheckpointCodec::Encode(system, position, data);
+  checkpoints_.push_back(Checkpoint{-1, std::move(data)});
+
+  std::string_view text = events_;
+  std::string_view line;
+  try {
+    while (not text.empty()) {
+      line = NextLine(text);
+
+      const auto event = MakeRecord(system, ParseEventLine(line));
+      if (position.last_event_minutes and
+          event.minutes < *position.last_event_minutes)
+        throw std::invalid_argument("Events are not in chronological order");
+      position.last_event_minutes = event.minutes;
+
+      system.Handle(event);
+
+      if (++position.events % interval_events != 0) continue;
+      position.input_offset = events_.size() - text.size();
+      CheckpointCodec::Encode(system, position, data);
+      checkpoints_.push_back(Checkpoint{event.minutes, std::move(data)});
+    }
+  } catch (const std::invalid_argument&) {
+    throw std::runtime_error(std::string(line));
+  } catch (const std::out_of_range&) {
+    throw std::runtime_error(std::string(line));
+  }
+}
+
+// A system of the day configuration, for RestoreAt
+CybercafeMonitoringSystem ReplayEngine::MakeSystem(OutputSink& output) const {
+  return CybercafeMonitoringSystem(
+      TimePoint{std::chrono::minutes{header_.opening_minutes}},
+      TimePoint{std::chrono::minutes{header_.closing_minutes}},
+      header_.tables_count, header_.hourly_rate, output);
+}
+
+// Restores into the system the state after every event until the time, closed
+// at or after the closing time. Returns the number of events handled after the
+// checkpoint
+uint64_t ReplayEngine::RestoreAt(int32_t minutes,
+                                 CybercafeMonitoringSystem& system) const {
+  // The first checkpoint is taken before any event, so it always fits
+  auto checkpoint = std::ranges::upper_bound(checkpoints_, minutes, {},
+                                             &Checkpoint::minutes);
+  if (checkpoint != checkpoints_.begin()) --checkpoint;
+
+  const CheckpointPosition position =
+      CheckpointCodec::Decode(checkpoint->data, system);
+
+  // The events were checked when the engine was built
+  std::string_view text = events_.substr(position.input_offset);
+  uint64_t handled = 0;
+  for (; not text.empty(); ++handled) {
+    std::string_view rest = text;
+    const ParsedEventLine event = ParseEventLine(NextLine(rest));
+    if (ToMinutes(event) > minutes) break;
+
+    system.Handle(MakeRecord(system, event));
+    text = rest;
+  }
+
+  // From the closing time on the day is closed, after the events until then
+  if (minutes >= header_.closing_minutes) system.EndWorkDayTrigger();
+
+  return handled;
+}
+
+// Prints the time, every occupied table with its client and the waiting queue
+// from the front
+void ReplayEngine::PrintStateAt(int32_t minutes, OutputSink& output) const {
+  NullOutputSink replay_output;
+  CybercafeMonitoringSystem system = MakeSystem(replay_output);
+  RestoreAt(minutes, system);
+
+  output.Print("{:02}:{:02}\n", minutes / 60, minutes % 60);
+  for (int table_id = 1; table_id <= header_.tables_count; ++table_id)
+    if (std::string_view client = system.GetTableOccupant(table_id);
+        not client.empty())
+      output.Print("{} {}\n", table_id, client);
+
+  output.Write("waiting:");
+  system.ForEachWaitingClient([&output](std::string_view client) {
+    output.Put(' ');
+    output.Write(client);
+  });
+  output.Put('\n');
+}
+
+}  // namespace cybercafe_monitoring_system
@@ -0,0 +1,166 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Ledger of the table sessions of a day and their re-pricing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/session_ledger.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using cybercafe_monitoring_system::RevenueReport;
+using cybercafe_monitoring_system::SessionLedger;
+using cybercafe_monitoring_system::TariffPlan;
+
+// Sessions priced per step, small enough for the block arrays to stay in L1
+constexpr size_t kBlockSize = 1024;
+
+constexpr int32_t kMinutesPerDay = 24 * 60;
+
+void CheckPlan(const TariffPlan& plan) {
+  if (plan.rate < 0 or plan.billing_minutes < 1 or plan.session_cap < 0)
+    throw std::invalid_argument(
+        std::format("Incorrect tariff plan: rate {}, billing minutes {}, "
+                    "session cap {}",
+                    plan.rate, plan.billing_minutes, plan.session_cap));
+}
+
+// Checks every session against the reports in one pass and returns the
+// longest session length
+int32_t CheckSessions(const SessionLedger& ledger, int tables_count) {
+  const auto tables = ledger.GetTables();
+  const auto starts = ledger.GetStarts();
+  const auto ends = ledger.GetEnds();
+
+  int32_t min_table = 1, max_table = 1, min_start = 0, max_start = 0;
+  int32_t max_end = 0;
+  int64_t min_duration = 0, max_duration = 0;
+  for (size_t i = 0; i != ledger.Size(); ++i) {
+    const int64_t duration = int64_t{ends[i]} - starts[i];
+    min_table = std::min(min_table, tables[i]);
+    max_table = std::max(max_table, tables[i]);
+    min_start = std::min(min_start, starts[i]);
+    max_start = std::max(max_start, starts[i]);
+    max_end = std::max(max_end, ends[i]);
+    min_duration = std::min(min_duration, duration);
+    max_duration = std::max(max_duration, duration);
+  }
+
+  // Every session lies within the day, so its start hour is below 24
+  if (min_table < 1 or max_table > tables_count or min_start < 0 or
+      max_start >= kMinutesPerDay or max_end > kMinutesPerDay or
+      min_duration < 0)
+    throw std::invalid_argument("Sessions do not fit the revenue reports");
+
+  return static_cast<int32_t>(max_duration);
+}
+
+// Price of every session length from 0 to max_duration minutes
+void FillPrices(const TariffPlan& plan, int32_t max_duration,
+                std::vector<int64_t>& prices) {
+  const int64_t cap = plan.session_cap == 0
+                          ? std::numeric_limits<int64_t>::max()
+                          : plan.session_cap;
+
+  prices.resize(static_cast<size_t>(max_duration) + 1);
+  for (int64_t duration = 0; duration <= max_duration; ++duration)
+    prices[static_cast<size_t>(duration)] = std::min(
+        (duration + plan.billing_minutes - 1) / plan.billing_minutes *
+            plan.rate,
+        cap);
+}
+
+}  // namespace
+
+namespace cybercafe_monitoring_system {
+
+// Forgets the sessions and the names without releasing the arrays
+void SessionLedger::Clear() {
+  ledger_ids_.clear();
+  names_.clear();
+  name_offsets_.resize(1);
+  clients_.clear();
+  tables_.clear();
+  starts_.clear();
+  ends_.clear();
+  charges_.clear();
+}
+
+// Returns the ledger id of the copied name
+ClientId SessionLedger::AddClientName(std::string_view client_name) {
+  names_.append(client_name);
+  name_offsets_.push_back(names_.size());
+  return static_cast<ClientId>(name_offsets_.size() - 2);
+}
+
+// Adds the revenue of the ledger sessions under every plan to the report of
+// the same index. Session lengths and start hours are computed once per
+// block, then every plan prices the block with one lookup per session
+void RepriceSessions(const SessionLedger& ledger,
+                     std::span<const TariffPlan> plans,
+                     std::span<RevenueReport> reports) {
+  if (plans.size() != reports.size())
+    throw std::invalid_argument(
+        std::format("{} tariff plans for {} revenue reports", plans.size(),
+                    reports.size()));
+
+  int tables_count = std::numeric_limits<int>::max();
+  for (const RevenueReport& report : reports)
+    tables_count =
+        std::min(tables_count, static_cast<int>(report.tables.size()));
+  for (const TariffPlan& plan : plans) CheckPlan(plan);
+  const int32_t max_duration = CheckSessions(ledger, tables_count);
+
+  std::vector<std::vector<int64_t>> prices(plans.size());
+  for (size_t plan = 0; plan != plans.size(); ++plan)
+    FillPrices(plans[plan], max_duration, prices[plan]);
+
+  const auto tables = ledger.GetTables();
+  const auto starts = ledger.GetStarts();
+  const auto ends = ledger.GetEnds();
+
+  std::array<int32_t, kBlockSize> durations, hours;
+  std::array<int64_t, kBlockSize> charges;
+  for (size_t begin = 0; begin < ledger.Size(); begin += kBlockSize) {
+    const size_t count = std::min(kBlockSize, ledger.Size() - begin);
+
+    for (size_t i = 0; i != count; ++i) {
+      durations[i] = ends[begin + i] - starts[begin + i];
+      hours[i] = starts[begin + i] / 60;
+    }
+
+    for (size_t plan = 0; plan != plans.size(); ++plan) {
+      const int64_t* price = prices[plan].data();
+      for (size_t i = 0; i != count; ++i)
+        charges[i] = price[static_cast<size_t>(durations[i])];
+
+      RevenueReport& report = reports[plan];
+      int64_t total = 0;
+      for (size_t i = 0; i != count; ++i) total += charges[i];
+      report.total += total;
+
+      for (size_t i = 0; i != count; ++i)
+        report.tables[static_cast<size_t>(tables[begin + i] - 1)] +=
+            charges[i];
+      for (size_t i = 0; i != count; ++i)
+        report.hours[static_cast<size_t>(hours[i])] += charges[i];
+    }
+  }
+}
+
+}  // namespace cybercafe_monitoring_system
@@ -0,0 +1,66 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Optional counters and timers of the cybercafe monitoring system hot path
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/system_instruments.h"
+
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <string_view>
+
+#include "include/output_sink.h"
+
+namespace cybercafe_monitoring_system {
+
+// Prints the counters and the p50/p99/max of every handler
+void PrintInstrumentsSnapshot(const InstrumentsSnapshot& snapshot,
+                              OutputSink& output) {
+  constexpr std::array<int, 7> kEventIds = {1, 2, 3, 4, 11, 12, 13};
+  constexpr std::array<std::string_view, kInstrumentedHandlersCount>
+      kHandlersNames = {"ClientArrived", "ClientSatAtTable", "ClientWaiting",
+                        "ClientLeft", "ClientDeparture"};
+
+  output.Write("events");
+  for (int id : kEventIds) output.Print(" {}:{}", id, snapshot.events[id]);
+
+  output.Write("\nerrors");
+  for (size_t i = 0; i != kErrorReasonsCount; ++i)
+    output.Print(" {}:{}", GetErrorReasonText(static_cast<ErrorReason>(i)),
+                 snapshot.errors[i]);
+
+  output.Print("\nmax waiting clients {} max occupied tables {}\n",
+               snapshot.max_waiting_clients, snapshot.max_occupied_tables);
+
+  for (size_t i = 0; i != kInstrumentedHandlersCount; ++i) {
+    const LatencyHistogram& latency = snapshot.handlers_latency[i];
+    output.Print("{} count {} p50 {}ns p99 {}ns max {}ns\n", kHandlersNames[i],
+                 latency.GetCount(), latency.Percentile(0.50).count(),
+                 latency.Percentile(0.99).count(),
+                 latency.Percentile(1.0).count());
+  }
+}
+
+#ifdef CYBERCAFE_INSTRUMENTATION
+
+// Prints the snapshot to the report sink
+void SystemInstruments::Report() const {
+  if (report_ != nullptr) {
+    PrintInstrumentsSnapshot(snapshot_, *report_);
+    report_->Flush();
+    return;
+  }
+
+  StreamOutputSink report(std::cerr);
+  PrintInstrumentsSnapshot(snapshot_, report);
+}
+
+#endif
+
+}  // namespace cybercafe_monitoring_system
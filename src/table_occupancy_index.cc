@@ -0,0 +1,41 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Dense index of occupied tables
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/table_occupancy_index.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace cybercafe_monitoring_system {
+
+TableOccupancyIndex::TableOccupancyIndex(int tables_count)
+    : tables_count_(std::max(tables_count, 0)),
+      occupied_((static_cast<size_t>(tables_count_) + kBitsPerWord - 1) /
+                kBitsPerWord),
+      occupants_(static_cast<size_t>(tables_count_), kNoClient) {}
+
+// Returns the smallest free table id or 0 if all tables are occupied
+int TableOccupancyIndex::FindFirstFreeTable() const {
+  for (size_t word = 0, word_end = occupied_.size(); word != word_end;
+       ++word) {
+    if (occupied_[word] == ~uint64_t{0}) continue;
+
+    const int table_id =
+        static_cast<int>(word * kBitsPerWord) +
+        std::countr_zero(static_cast<uint64_t>(~occupied_[word])) + 1;
+
+    return table_id <= tables_count_ ? table_id : 0;
+  }
+
+  return 0;
+}
+
+}  // namespace cybercafe_monitoring_system
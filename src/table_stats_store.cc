@@ -0,0 +1,42 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Dense per-table daily statistics of the cybercafe monitoring system
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/table_stats_store.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+namespace cybercafe_monitoring_system {
+
+TableStatsStore::TableStatsStore(int tables_count)
+    : tables_count_(std::max(tables_count, 0)),
+      session_start_(static_cast<size_t>(tables_count_)),
+      used_minutes_(static_cast<size_t>(tables_count_)),
+      revenue_(static_cast<size_t>(tables_count_)) {}
+
+// Zeroes the daily statistics without reallocating
+void TableStatsStore::Reset() {
+  std::ranges::fill(session_start_, 0);
+  std::ranges::fill(used_minutes_, 0);
+  std::ranges::fill(revenue_, 0);
+}
+
+// Sum of the revenue of all tables
+int64_t TableStatsStore::GetTotalRevenue() const {
+  return std::reduce(revenue_.begin(), revenue_.end(), int64_t{0});
+}
+
+// Sum of the used minutes of all tables
+int64_t TableStatsStore::GetTotalUsedMinutes() const {
+  return std::reduce(used_minutes_.begin(), used_minutes_.end(), int64_t{0});
+}
+
+}  // namespace cybercafe_monitoring_system
@@ -0,0 +1,243 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Many cybercafe venues hosted in one process
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/venue_engine.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <format>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// Keeps the worker on one core, so its venues stay in that core's caches.
+// Does nothing where thread affinity is not supported
+void PinToCore(std::jthread& worker, size_t core) {
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(core % std::max(std::thread::hardware_concurrency(), 1u), &cpu_set);
+  pthread_setaffinity_np(worker.native_handle(), sizeof(cpu_set), &cpu_set);
+#else
+  (void)worker;
+  (void)core;
+#endif
+}
+
+}  // namespace
+
+namespace cybercafe_monitoring_system {
+
+VenueEngine::VenueEngine(size_t shards_count, size_t queue_capacity) {
+  if (shards_count == 0)
+    shards_count = std::max(std::thread::hardware_concurrency(), 1u);
+
+  shards_.reserve(shards_count);
+  for (size_t i = 0; i != shards_count; ++i)
+    shards_.push_back(std::make_unique<Shard>(queue_capacity));
+}
+
+// Stops the workers after the queued events are handled
+VenueEngine::~VenueEngine() { Stop(); }
+
+void VenueEngine::AddVenue(VenueId venue_id, const VenueConfig& config,
+                           OutputSink& output) {
+  if (running_)
+    throw std::invalid_argument("Venues are added before the engine starts");
+  if (routes_.contains(venue_id))
+    throw std::invalid_argument(
+        std::format("Venue is already added: {}", venue_id));
+
+  // Round robin keeps the shards equally loaded
+  const size_t shard = routes_.size() % shards_.size();
+  auto& venue = shards_[shard]->venues.emplace_back(
+      std::make_unique<Venue>(venue_id, config, output));
+  routes_.emplace(venue_id, std::pair{venue.get(), shard});
+}
+
+// Starts the shard workers
+void VenueEngine::Start() {
+  if (running_) return;
+  running_ = true;
+
+  for (size_t i = 0, iend = shards_.size(); i != iend; ++i) {
+    Shard* shard = shards_[i].get();
+    shard->worker = std::jthread([shard] { shard->Run(); });
+    PinToCore(shard->worker, i);
+  }
+}
+
+// Handles the queued events and stops the shard workers
+void VenueEngine::Stop() {
+  if (not running_) return;
+
+  for (auto& shard : shards_) shard->queue.Push(Message(Message::Kind::kStop));
+  for (auto& shard : shards_) shard->worker.join();
+
+  running_ = false;
+}
+
+void VenueEngine::OpenDay(VenueId venue_id) {
+  Route(venue_id, Message(Message::Kind::kOpenDay));
+}
+
+// Queues an incoming event of the venue
+void VenueEngine::Submit(VenueId venue_id, const TimePoint& time,
+                         CybercafeMonitoringSystem::Event::Id id,
+                         std::string_view client_name, int table_id) {
+  Route(venue_id,
+        Message(Message::Kind::kEvent, time, id, client_name, table_id));
+}
+
+void VenueEngine::CloseDay(VenueId venue_id) {
+  Route(venue_id, Message(Message::Kind::kCloseDay));
+}
+
+// Waits until every queued message is handled
+void VenueEngine::Drain() {
+  if (not running_) return;
+
+  for (auto& shard : shards_)
+    for (uint64_t handled;
+         (handled = shard->handled.load(std::memory_order_acquire)) <
+         shard->submitted;)
+      shard->handled.wait(handled, std::memory_order_acquire);
+}
+
+// Drains the queues and returns the venue results
+VenueTotals VenueEngine::GetVenueTotals(VenueId venue_id) {
+  Drain();
+  return FindRoute(venue_id).first->totals;
+}
+
+// Drains the queues and sums the results of all venues
+ChainTotals VenueEngine::GetChainTotals() {
+  Drain();
+
+  ChainTotals chain;
+  for (const auto& [venue_id, route] : routes_) {
+    const VenueTotals& venue = route.first->totals;
+    chain.revenue += venue.revenue;
+    chain.used_minutes += venue.used_minutes;
+    chain.handled_events += venue.handled_events;
+    chain.rejected_events += venue.rejected_events;
+    if (venue.failed) ++chain.failed_venues_count;
+  }
+  chain.venues_count = routes_.size();
+
+  return chain;
+}
+
+// Routes the message to the shard of the venue
+void VenueEngine::Route(VenueId venue_id, Message message) {
+  if (not running_) throw std::invalid_argument("The engine is not started");
+
+  const auto& [venue, shard] = FindRoute(venue_id);
+  message.venue = venue;
+
+  ++shards_[shard]->submitted;
+  shards_[shard]->queue.Push(std::move(message));
+}
+
+const std::pair<VenueEngine::Venue*, size_t>& VenueEngine::FindRoute(
+    VenueId venue_id) const {
+  auto route = routes_.find(venue_id);
+  if (route == routes_.end())
+    throw std::invalid_argument(std::format("Unknown venue: {}", venue_id));
+
+  return route->second;
+}
+
+// Handles messages until kStop
+void VenueEngine::Shard::Run() {
+  for (;;) {
+    Message message = queue.Pop();
+    if (message.kind == Message::Kind::kStop) return;
+
+    Handle(message);
+
+    handled.fetch_add(1, std::memory_order_release);
+    handled.notify_all();
+  }
+}
+
+// Handles one message on the worker thread. An error fails only the venue of
+// the message, the shard goes on with the others
+void VenueEngine::Shard::Handle(Message& message) {
+  Venue& venue = *message.venue;
+  if (venue.totals.failed) return;
+
+  try {
+    switch (message.kind) {
+      case Message::Kind::kOpenDay:
+        venue.previous_minutes.reset();
+        venue.system.StartWorkDayTrigger();
+        break;
+      case Message::Kind::kEvent:
+        HandleEvent(venue, message);
+        break;
+      case Message::Kind::kCloseDay:
+        venue.system.EndWorkDayTrigger();
+        venue.totals.revenue = venue.system.GetTotalRevenue();
+        venue.totals.used_minutes +=
+            venue.system.GetTablesStats().GetTotalUsedMinutes();
+        break;
+      case Message::Kind::kStop:
+        break;
+    }
+  } catch (const std::exception&) {
+    venue.totals.failed = true;
+  }
+}
+
+// Handles one event, an incorrect one is rejected before it is printed
+void VenueEngine::Shard::HandleEvent(Venue& venue, const Message& message) {
+  using Id = CybercafeMonitoringSystem::Event::Id;
+
+  const auto minutes =
+      static_cast<int32_t>(message.time.time_since_epoch().count());
+  if (venue.previous_minutes and minutes < *venue.previous_minutes) {
+    ++venue.totals.rejected_events;
+    return;
+  }
+
+  CybercafeMonitoringSystem::EventRecord record;
+  try {
+    record = venue.system.MakeEventRecord(message.time, message.id,
+                                          message.client_name,
+                                          message.table_id);
+  } catch (const std::invalid_argument&) {
+    ++venue.totals.rejected_events;
+    return;
+  }
+
+  const int tables_count = venue.system.GetTablesStats().GetTablesCount();
+  if (message.id == Id::k2 and
+      (message.table_id < 1 or message.table_id > tables_count)) {
+    ++venue.totals.rejected_events;
+    return;
+  }
+
+  venue.system.Handle(record);
+  venue.previous_minutes = minutes;
+  ++venue.totals.handled_events;
+}
+
+}  // namespace cybercafe_monitoring_system
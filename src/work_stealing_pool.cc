@@ -0,0 +1,103 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Work stealing thread pool for independent tasks
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/work_stealing_pool.h"
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Task indices of one worker. Aligned so that the locks of neighbouring
+// workers do not share a cache line
+struct alignas(64) WorkerQueue {
+  std::mutex mutex;
+
+  std::deque<size_t> tasks;
+
+  // The owner takes tasks from the front
+  std::optional<size_t> PopFront() {
+    std::lock_guard lock(mutex);
+    if (tasks.empty()) return std::nullopt;
+    size_t task = tasks.front();
+    tasks.pop_front();
+    return task;
+  }
+
+  // Thieves take tasks from the back
+  std::optional<size_t> PopBack() {
+    std::lock_guard lock(mutex);
+    if (tasks.empty()) return std::nullopt;
+    size_t task = tasks.back();
+    tasks.pop_back();
+    return task;
+  }
+};
+
+}  // namespace
+
+namespace cybercafe_monitoring_system {
+
+WorkStealingPool::WorkStealingPool(size_t threads_count)
+    : threads_count_(threads_count != 0
+                         ? threads_count
+                         : std::max(std::thread::hardware_concurrency(), 1u)) {}
+
+// Calls task(i) for every i in [0, tasks_count) and returns when all calls
+// are done
+void WorkStealingPool::ForEach(size_t tasks_count,
+                               const std::function<void(size_t)>& task) const {
+  const size_t workers_count = std::min(threads_count_, tasks_count);
+  if (workers_count == 0) return;
+
+  std::vector<WorkerQueue> queues(workers_count);
+  for (size_t i = 0; i != tasks_count; ++i)
+    queues[i % workers_count].tasks.push_back(i);
+
+  std::mutex error_mutex;
+  std::exception_ptr first_error;
+
+  auto run_worker = [&](size_t worker) {
+    // No tasks are added while running, so all queues empty means done
+    for (;;) {
+      std::optional<size_t> next = queues[worker].PopFront();
+      for (size_t offset = 1; not next and offset != workers_count; ++offset)
+        next = queues[(worker + offset) % workers_count].PopBack();
+      if (not next) return;
+
+      try {
+        task(*next);
+      } catch (...) {
+        std::lock_guard lock(error_mutex);
+        if (not first_error) first_error = std::current_exception();
+      }
+    }
+  };
+
+  {
+    std::vector<std::jthread> workers;
+    workers.reserve(workers_count - 1);
+    for (size_t worker = 1; worker != workers_count; ++worker)
+      workers.emplace_back(run_worker, worker);
+
+    // The calling thread is a worker too
+    run_worker(0);
+  }
+
+  if (first_error) std::rethrow_exception(first_error);
+}
+
+}  // namespace cybercafe_monitoring_system
@@ -0,0 +1,131 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Batch processing testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "include/batch_runner.h"
+#include "include/output_sink.h"
+#include "include/read_input_data.h"
+#include "tests/processing_test_helpers.h"
+
+namespace {
+
+namespace test = cybercafe_monitoring_system_test;
+
+constexpr std::string_view kValidDay =
+    "2\n"
+    "09:00 19:00\n"
+    "10\n"
+    "09:10 1 client1\n"
+    "09:20 2 client1 1\n"
+    "10:30 4 client1\n";
+
+class BatchRunnerTest : public test::TempDirTest {
+ protected:
+  void SetUp() override {
+    TempDirTest::SetUp();
+    std::filesystem::create_directories(temp_dir / "in" / "venue2");
+  }
+
+  static std::string ReadFile(const std::filesystem::path& path) {
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+
+  // Output of the single file mode for the same input
+  static std::string ProcessSingle(std::string_view content) {
+    std::istringstream in{std::string(content)};
+    cybercafe_monitoring_system::MemoryOutputSink output;
+    test::ProcessingInputData(in, output);
+    return std::string(output.View());
+  }
+};
+
+TEST_F(BatchRunnerTest, EveryInputGetsItsOwnOutput) {
+  std::vector<std::filesystem::path> inputs;
+  for (int i = 0; i != 20; ++i)
+    inputs.push_back(CreateFile(std::format("in/day{}.txt", i), kValidDay));
+
+  test::BatchOptions options{.output_dir = temp_dir / "out",
+                             .threads_count = 4};
+  test::BatchResult result = test::RunBatch(inputs, options);
+
+  ASSERT_EQ(result.files.size(), inputs.size());
+  EXPECT_EQ(result.GetFailedCount(), 0u);
+  for (size_t i = 0; i != inputs.size(); ++i) {
+    EXPECT_EQ(result.files[i].input_path, inputs[i]);
+    EXPECT_EQ(result.files[i].output_path.filename(),
+              std::format("day{}.txt.out", i));
+    EXPECT_EQ(ReadFile(result.files[i].output_path), ProcessSingle(kValidDay));
+  }
+}
+
+TEST_F(BatchRunnerTest, FailedInputDoesNotStopOthers) {
+  std::vector<std::filesystem::path> inputs = {
+      CreateFile("in/bad.txt", "2\n09:00 19:00\n10\n09:10 1 Client1\n"),
+      CreateFile("in/unordered.txt",
+                 "2\n09:00 19:00\n10\n09:10 1 client1\n09:00 1 client2\n"),
+      CreateFile("in/good.txt", kValidDay),
+      temp_dir / "in" / "missing.txt",
+  };
+
+  test::BatchResult result =
+      test::RunBatch(inputs, {.output_dir = temp_dir / "out"});
+
+  EXPECT_EQ(result.GetFailedCount(), 3u);
+  EXPECT_EQ(result.files[0].error, "09:10 1 Client1");
+  EXPECT_FALSE(result.files[1].error.empty());
+  EXPECT_TRUE(result.files[2].error.empty());
+  EXPECT_FALSE(result.files[3].error.empty());
+
+  cybercafe_monitoring_system::MemoryOutputSink summary;
+  test::PrintBatchSummary(result, summary);
+  EXPECT_NE(summary.View().find("total: 4 files 3 failed"),
+            std::string_view::npos);
+}
+
+TEST_F(BatchRunnerTest, CollectsDirectoriesAndManifests) {
+  CreateFile("in/b.txt", kValidDay);
+  CreateFile("in/a.txt", kValidDay);
+  CreateFile("in/venue2/a.txt", kValidDay);
+  CreateFile("manifest.txt", "in/venue2/a.txt\n\nin/b.txt\n");
+
+  const std::string directory = (temp_dir / "in").string();
+  const std::string manifest = "@" + (temp_dir / "manifest.txt").string();
+  std::vector<std::string_view> arguments = {directory, manifest};
+
+  auto inputs = test::CollectBatchInputs(arguments);
+
+  ASSERT_EQ(inputs.size(), 4u);
+  EXPECT_EQ(inputs[0], temp_dir / "in" / "a.txt");
+  EXPECT_EQ(inputs[1], temp_dir / "in" / "b.txt");
+  EXPECT_EQ(inputs[2], temp_dir / "in" / "venue2" / "a.txt");
+  EXPECT_EQ(inputs[3], temp_dir / "in" / "b.txt");
+
+  test::BatchResult result =
+      test::RunBatch(inputs, {.output_dir = temp_dir / "out"});
+
+  EXPECT_EQ(result.files[0].output_path.filename(), "a.txt.out");
+  EXPECT_EQ(result.files[1].output_path.filename(), "b.txt.out");
+  EXPECT_EQ(result.files[2].output_path.filename(), "a.txt.1.out");
+  EXPECT_EQ(result.files[3].output_path.filename(), "b.txt.1.out");
+}
+
+}  // namespace
@@ -0,0 +1,226 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Binary event log testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/binary_event_log.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "include/client_name_interner.h"
+#include "include/cybercafe_monitoring_system.h"
+#include "include/output_sink.h"
+#include "include/read_input_data.h"
+#include "tests/processing_test_helpers.h"
+
+namespace {
+
+using cybercafe_monitoring_system::BinaryEventLogReader;
+using cybercafe_monitoring_system::BinaryEventLogWriter;
+using cybercafe_monitoring_system::ClientId;
+using cybercafe_monitoring_system::EventLogHeader;
+using cybercafe_monitoring_system::MemoryOutputSink;
+using EventRecord =
+    cybercafe_monitoring_system::CybercafeMonitoringSystem::EventRecord;
+using Id = cybercafe_monitoring_system::CybercafeMonitoringSystem::Event::Id;
+
+// README sample input
+constexpr std::string_view kDay =
+    "3\n"
+    "09:00 19:00\n"
+    "10\n"
+    "08:48 1 client1\n"
+    "09:41 1 client1\n"
+    "09:48 1 client2\n"
+    "09:52 3 client1\n"
+    "09:54 2 client1 1\n"
+    "10:25 2 client2 2\n"
+    "10:58 1 client3\n"
+    "10:59 2 client3 3\n"
+    "11:30 1 client4\n"
+    "11:35 2 client4 2\n"
+    "11:45 3 client4\n"
+    "12:33 4 client1\n"
+    "12:43 4 client2\n"
+    "15:52 4 client4\n";
+
+class BinaryEventLogTest
+    : public cybercafe_monitoring_system_test::TempDirTest {
+ protected:
+  std::string ReadFile(const std::string& filename) const {
+    std::ifstream in(temp_dir / filename, std::ios::binary);
+    std::stringstream content;
+    content << in.rdbuf();
+    return content.str();
+  }
+
+  // Output of the text processing of the content
+  std::string ProcessText(std::string_view content) const {
+    std::istringstream in{std::string(content)};
+    MemoryOutputSink output;
+    cybercafe_monitoring_system_test::ProcessingInputData(
+        in, output, cybercafe_monitoring_system_test::InputMode::kStreaming);
+    return std::string(output.View());
+  }
+};
+
+TEST_F(BinaryEventLogTest, ReplayMatchesTextProcessing) {
+  const auto text_path = CreateFile("day.txt", kDay);
+  cybercafe_monitoring_system_test::ConvertTextToBinaryLog(
+      text_path, temp_dir / "day.bin");
+
+  MemoryOutputSink output;
+  cybercafe_monitoring_system_test::ProcessingBinaryInputData(
+      temp_dir / "day.bin", output);
+  EXPECT_EQ(output.View(), ProcessText(kDay));
+}
+
+TEST_F(BinaryEventLogTest, TextRoundTrip) {
+  const auto text_path = CreateFile("day.txt", kDay);
+  cybercafe_monitoring_system_test::ConvertTextToBinaryLog(
+      text_path, temp_dir / "day.bin");
+  cybercafe_monitoring_system_test::ConvertBinaryToTextLog(
+      temp_dir / "day.bin", temp_dir / "back.txt");
+
+  EXPECT_EQ(ReadFile("back.txt"), kDay);
+}
+
+TEST_F(BinaryEventLogTest, ManyBlocksAndLongSteps) {
+  const EventLogHeader header{9 * 60, 19 * 60, 1000, 10};
+  {
+    BinaryEventLogWriter writer(temp_dir / "many.bin", header);
+    for (int i = 0; i != 10000; ++i)
+      writer.Append(i * 7 % 1440, i % 2 == 0 ? Id::k2 : Id::k4,
+                    "client" + std::to_string(i % 300),
+                    i % 2 == 0 ? 1 + i % 1000 : 0);
+    writer.Finish();
+  }
+
+  // About 20 bytes of text per event
+  EXPECT_LT(std::filesystem::file_size(temp_dir / "many.bin"), 10000u * 5);
+
+  std::ifstream in(temp_dir / "many.bin", std::ios::binary);
+  const std::string data{std::istreambuf_iterator<char>(in), {}};
+  BinaryEventLogReader reader(data);
+  EXPECT_EQ(reader.GetHeader().tables_count, 1000);
+  ASSERT_EQ(reader.GetClientsCount(), 300u);
+  EXPECT_EQ(reader.GetClientName(299), "client299");
+
+  std::vector<ClientId> clients(reader.GetClientsCount());
+  std::iota(clients.begin(), clients.end(), ClientId{100});
+
+  int i = 0;
+  std::vector<EventRecord> events;
+  while (reader.NextBlock(clients, events)) {
+    for (const EventRecord& event : events) {
+      EXPECT_EQ(event.minutes, i * 7 % 1440);
+      EXPECT_EQ(event.id, i % 2 == 0 ? Id::k2 : Id::k4);
+      EXPECT_EQ(event.client, static_cast<ClientId>(100 + i % 300));
+      EXPECT_EQ(event.table_id, i % 2 == 0 ? 1 + i % 1000 : 0);
+      ++i;
+    }
+  }
+  EXPECT_EQ(i, 10000);
+}
+
+TEST_F(BinaryEventLogTest, DamagedLogThrows) {
+  const auto text_path = CreateFile("day.txt", kDay);
+  cybercafe_monitoring_system_test::ConvertTextToBinaryLog(
+      text_path, temp_dir / "day.bin");
+  const std::string data = ReadFile("day.bin");
+
+  std::string damaged_block = data;
+  damaged_block[46] ^= 0x04;
+  const auto damaged_block_path = CreateFile("block.bin", damaged_block);
+  MemoryOutputSink output;
+  EXPECT_THROW(cybercafe_monitoring_system_test::ProcessingBinaryInputData(
+                   damaged_block_path, output),
+               std::runtime_error);
+
+  std::string damaged_name = data;
+  damaged_name[damaged_name.rfind("client1")] = 'C';
+  EXPECT_THROW(BinaryEventLogReader{damaged_name}, std::runtime_error);
+
+  EXPECT_THROW(BinaryEventLogReader{data.substr(0, data.size() - 3)},
+               std::runtime_error);
+  EXPECT_THROW(BinaryEventLogReader{kDay}, std::runtime_error);
+
+  std::string other_version = data;
+  other_version[8] ^= 0x7F;
+  EXPECT_THROW(BinaryEventLogReader{other_version}, std::runtime_error);
+}
+
+TEST_F(BinaryEventLogTest, ConversionReportsIncorrectLine) {
+  const auto text_path = CreateFile(
+      "bad.txt", "3\n09:00 19:00\n10\n09:10 1 client1\n09:20 1 Client2\n");
+  try {
+    cybercafe_monitoring_system_test::ConvertTextToBinaryLog(
+        text_path, temp_dir / "bad.bin");
+    FAIL() << "Expected std::runtime_error";
+  } catch (const std::runtime_error& e) {
+    EXPECT_STREQ(e.what(), "09:20 1 Client2");
+  }
+
+  // The log is unfinished and is not read
+  EXPECT_THROW(cybercafe_monitoring_system_test::ConvertBinaryToTextLog(
+                   temp_dir / "bad.bin", temp_dir / "bad_back.txt"),
+               std::runtime_error);
+}
+
+TEST_F(BinaryEventLogTest, TableOutOfTheTablesCountIsRejected) {
+  const auto text_path = CreateFile(
+      "bad.txt", "3\n09:00 19:00\n10\n09:10 1 client1\n09:20 2 client1 7\n");
+  try {
+    cybercafe_monitoring_system_test::ConvertTextToBinaryLog(
+        text_path, temp_dir / "bad.bin");
+    FAIL() << "Expected std::runtime_error";
+  } catch (const std::runtime_error& e) {
+    EXPECT_STREQ(e.what(), "09:20 2 client1 7");
+  }
+
+  // A log written without the check is not replayed either
+  {
+    BinaryEventLogWriter writer(temp_dir / "bad.bin",
+                                EventLogHeader{9 * 60, 19 * 60, 3, 10});
+    writer.Append(9 * 60 + 10, Id::k1, "client1");
+    writer.Append(9 * 60 + 20, Id::k2, "client1", 7);
+    writer.Finish();
+  }
+  MemoryOutputSink output;
+  try {
+    cybercafe_monitoring_system_test::ProcessingBinaryInputData(
+        temp_dir / "bad.bin", output);
+    FAIL() << "Expected std::runtime_error";
+  } catch (const std::runtime_error& e) {
+    EXPECT_STREQ(e.what(), "Corrupt event log: bad table");
+  }
+}
+
+TEST_F(BinaryEventLogTest, ReplayReportsOrderViolation) {
+  constexpr std::string_view kUnordered =
+      "3\n09:00 19:00\n10\n09:10 1 client1\n09:05 1 client2\n";
+  const auto text_path = CreateFile("unordered.txt", kUnordered);
+  cybercafe_monitoring_system_test::ConvertTextToBinaryLog(
+      text_path, temp_dir / "unordered.bin");
+
+  MemoryOutputSink output;
+  EXPECT_THROW(cybercafe_monitoring_system_test::ProcessingBinaryInputData(
+                   temp_dir / "unordered.bin", output),
+               cybercafe_monitoring_system_test::EventsOrderViolation);
+  EXPECT_EQ(output.View(), "09:00\n09:10 1 client1\n09:05 1 client2\n");
+}
+
+}  // namespace
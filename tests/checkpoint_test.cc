@@ -0,0 +1,245 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Crash-safe state snapshots testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/checkpoint.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "include/cybercafe_monitoring_system.h"
+#include "include/event_line_parser.h"
+#include "include/output_sink.h"
+#include "include/read_input_data.h"
+#include "tests/processing_test_helpers.h"
+
+namespace {
+
+using cybercafe_monitoring_system::CheckpointCodec;
+using cybercafe_monitoring_system::CheckpointPosition;
+using cybercafe_monitoring_system::CybercafeMonitoringSystem;
+using cybercafe_monitoring_system::MemoryOutputSink;
+using cybercafe_monitoring_system::TimePoint;
+
+// README sample day
+constexpr std::string_view kDay[] = {
+    "08:48 1 client1",   "09:41 1 client1",   "09:48 1 client2",
+    "09:52 3 client1",   "09:54 2 client1 1", "10:25 2 client2 2",
+    "10:58 1 client3",   "10:59 2 client3 3", "11:30 1 client4",
+    "11:35 2 client4 2", "11:45 3 client4",   "12:33 4 client1",
+    "12:43 4 client2",   "15:52 4 client4",
+};
+
+// The state in the middle of the day: seated, waiting and gone clients
+constexpr size_t kCheckpointEvent = 11;
+
+TimePoint Minutes(int minutes) {
+  return TimePoint{std::chrono::minutes{minutes}};
+}
+
+void HandleLine(CybercafeMonitoringSystem& system, std::string_view line) {
+  auto parsed = cybercafe_monitoring_system::ParseEventLine(line);
+  system.Handle(system.MakeEventRecord(parsed.time, parsed.id,
+                                       parsed.client_name, parsed.table_id));
+}
+
+// Output of the events after the checkpoint and of the closing
+std::string RunTail(CybercafeMonitoringSystem& system,
+                    MemoryOutputSink& output) {
+  output.Clear();
+  for (size_t i = kCheckpointEvent; i != std::size(kDay); ++i)
+    HandleLine(system, kDay[i]);
+  system.EndWorkDayTrigger();
+  return std::string(output.View());
+}
+
+class CheckpointTest : public cybercafe_monitoring_system_test::TempDirTest {
+ protected:
+  void SetUp() override {
+    TempDirTest::SetUp();
+
+    system.StartWorkDayTrigger();
+    for (size_t i = 0; i != kCheckpointEvent; ++i) HandleLine(system, kDay[i]);
+    CheckpointCodec::Encode(system, position, data);
+  }
+
+  MemoryOutputSink output, restored_output;
+
+  CybercafeMonitoringSystem system{Minutes(9 * 60), Minutes(19 * 60), 3, 10,
+                                   output};
+
+  CybercafeMonitoringSystem restored{Minutes(9 * 60), Minutes(19 * 60), 3, 10,
+                                     restored_output};
+
+  CheckpointPosition position{123, kCheckpointEvent, 11 * 60 + 45};
+
+  std::string data;
+};
+
+TEST_F(CheckpointTest, RestoredSystemContinuesTheDay) {
+  CheckpointPosition restored_position =
+      CheckpointCodec::Decode(data, restored);
+
+  EXPECT_EQ(restored_position.input_offset, 123u);
+  EXPECT_EQ(restored_position.events, kCheckpointEvent);
+  EXPECT_EQ(restored_position.last_event_minutes, 11 * 60 + 45);
+  EXPECT_EQ(RunTail(restored, restored_output), RunTail(system, output));
+}
+
+TEST_F(CheckpointTest, RestoredSystemEncodesTheSame) {
+  CheckpointCodec::Decode(data, restored);
+
+  std::string restored_data;
+  CheckpointCodec::Encode(restored, position, restored_data);
+  EXPECT_EQ(restored_data, data);
+}
+
+TEST_F(CheckpointTest, DamagedDataThrowsAndKeepsTheState) {
+  std::string damaged = data;
+  damaged[damaged.size() / 2] ^= 0x20;
+  EXPECT_THROW(CheckpointCodec::Decode(damaged, restored), std::runtime_error);
+
+  EXPECT_THROW(
+      CheckpointCodec::Decode(std::string_view(data).substr(0, 20), restored),
+      std::runtime_error);
+  EXPECT_THROW(CheckpointCodec::Decode(data + "x", restored),
+               std::runtime_error);
+  EXPECT_THROW(CheckpointCodec::Decode("not a checkpoint at all", restored),
+               std::runtime_error);
+
+  // The version follows the 8 bytes of the magic
+  std::string other_version = data;
+  other_version[8] ^= 0x7F;
+  EXPECT_THROW(CheckpointCodec::Decode(other_version, restored),
+               std::runtime_error);
+
+  std::string restored_data;
+  CheckpointCodec::Encode(restored, CheckpointPosition{}, restored_data);
+  CybercafeMonitoringSystem fresh{Minutes(9 * 60), Minutes(19 * 60), 3, 10,
+                                  restored_output};
+  std::string fresh_data;
+  CheckpointCodec::Encode(fresh, CheckpointPosition{}, fresh_data);
+  EXPECT_EQ(restored_data, fresh_data);
+}
+
+TEST_F(CheckpointTest, ClientsWhoLeftAreNotKept) {
+  MemoryOutputSink fresh_output;
+  CybercafeMonitoringSystem fresh{Minutes(9 * 60), Minutes(19 * 60), 3, 10,
+                                  fresh_output};
+  fresh.StartWorkDayTrigger();
+  std::string fresh_data;
+  CheckpointCodec::Encode(fresh, position, fresh_data);
+
+  for (int i = 0; i != 100; ++i) {
+    const std::string client = "guest" + std::to_string(i);
+    HandleLine(fresh, "10:00 1 " + client);
+    HandleLine(fresh, "10:00 4 " + client);
+  }
+  std::string visited_data;
+  CheckpointCodec::Encode(fresh, position, visited_data);
+  EXPECT_EQ(visited_data, fresh_data);
+}
+
+TEST_F(CheckpointTest, OtherConfigurationThrows) {
+  MemoryOutputSink other_output;
+  CybercafeMonitoringSystem other{Minutes(9 * 60), Minutes(19 * 60), 4, 10,
+                                  other_output};
+  EXPECT_THROW(CheckpointCodec::Decode(data, other), std::runtime_error);
+}
+
+TEST_F(CheckpointTest, FileRoundTrip) {
+  const auto path = temp_dir / "day.checkpoint";
+  cybercafe_monitoring_system::WriteCheckpoint(system, position, path);
+
+  EXPECT_FALSE(std::filesystem::exists(temp_dir / "day.checkpoint.tmp"));
+  cybercafe_monitoring_system::LoadCheckpoint(path, restored);
+  EXPECT_EQ(RunTail(restored, restored_output), RunTail(system, output));
+}
+
+TEST_F(CheckpointTest, ResumedRunPrintsTheTail) {
+  std::string day = "3\n09:00 19:00\n10\n";
+  for (std::string_view line : kDay) (day += line) += '\n';
+
+  const auto input_path = temp_dir / "day.txt";
+  const auto checkpoint_path = temp_dir / "day.checkpoint";
+  const cybercafe_monitoring_system_test::CheckpointOptions options{
+      checkpoint_path, 4};
+
+  MemoryOutputSink full_output;
+  std::ofstream(input_path) << day;
+  cybercafe_monitoring_system_test::ProcessingMappedInputData(
+      input_path, full_output, options);
+  EXPECT_FALSE(std::filesystem::exists(checkpoint_path));
+
+  // The run stops at a damaged line after two checkpoints, as if it crashed
+  std::string damaged_day = day;
+  damaged_day.replace(damaged_day.find("11:45 3"), 7, "11:45 9");
+  std::ofstream(input_path) << damaged_day;
+  MemoryOutputSink crashed_output;
+  EXPECT_THROW(cybercafe_monitoring_system_test::ProcessingMappedInputData(
+                   input_path, crashed_output, options),
+               std::runtime_error);
+  ASSERT_TRUE(std::filesystem::exists(checkpoint_path));
+
+  std::ofstream(input_path) << day;
+  MemoryOutputSink resumed_output;
+  cybercafe_monitoring_system_test::ProcessingMappedInputData(
+      input_path, resumed_output, options);
+
+  // Only the events after the eighth one are handled again
+  const std::string_view full = full_output.View();
+  const std::string_view resumed = resumed_output.View();
+  EXPECT_TRUE(resumed.starts_with("11:30 1 client4\n"));
+  EXPECT_TRUE(full.ends_with(resumed));
+  EXPECT_FALSE(std::filesystem::exists(checkpoint_path));
+}
+
+TEST_F(CheckpointTest, CheckpointOfAnotherInputThrows) {
+  std::string day = "3\n09:00 19:00\n10\n";
+  for (std::string_view line : kDay) (day += line) += '\n';
+
+  const auto input_path = temp_dir / "day.txt";
+  const auto checkpoint_path = temp_dir / "day.checkpoint";
+  const cybercafe_monitoring_system_test::CheckpointOptions options{
+      checkpoint_path, 4};
+
+  std::string damaged_day = day;
+  damaged_day.replace(damaged_day.find("11:45 3"), 7, "11:45 9");
+  std::ofstream(input_path) << damaged_day;
+  MemoryOutputSink crashed_output;
+  EXPECT_THROW(cybercafe_monitoring_system_test::ProcessingMappedInputData(
+                   input_path, crashed_output, options),
+               std::runtime_error);
+  ASSERT_TRUE(std::filesystem::exists(checkpoint_path));
+
+  // Another client in the handled part, of the same size, and one more line
+  std::string other_day = day;
+  other_day.replace(other_day.find("client2"), 7, "client7");
+  for (const std::string& input : {other_day, day + "16:00 1 client5\n"}) {
+    std::ofstream(input_path) << input;
+    MemoryOutputSink output;
+    try {
+      cybercafe_monitoring_system_test::ProcessingMappedInputData(
+          input_path, output, options);
+      ADD_FAILURE() << input;
+    } catch (const std::runtime_error& e) {
+      EXPECT_STREQ(e.what(), "Checkpoint does not match the input");
+    }
+    EXPECT_EQ(output.View(), "");
+    EXPECT_TRUE(std::filesystem::exists(checkpoint_path));
+  }
+}
+
+}  // namespace
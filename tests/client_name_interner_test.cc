@@ -0,0 +1,81 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Client name interning testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+#include "include/client_name_interner.h"
+
+namespace {
+
+using cybercafe_monitoring_system::ClientNameInterner;
+using cybercafe_monitoring_system::kNoClient;
+
+TEST(ClientNameInternerTest, AssignsDenseIdsInOrderOfAppearance) {
+  ClientNameInterner interner;
+
+  EXPECT_EQ(interner.Intern("client1"), 0u);
+  EXPECT_EQ(interner.Intern("client2"), 1u);
+  EXPECT_EQ(interner.Intern("client1"), 0u);
+  EXPECT_EQ(interner.Size(), 2u);
+
+  EXPECT_EQ(interner.GetName(1), "client2");
+  EXPECT_EQ(interner.Find("client2"), 1u);
+  EXPECT_EQ(interner.Find("client3"), kNoClient);
+}
+
+TEST(ClientNameInternerTest, KeepsOwnCopyOfNames) {
+  ClientNameInterner interner;
+
+  {
+    std::string temporary_name = "a_rather_long_client_name_0";
+    interner.Intern(temporary_name);
+    temporary_name[0] = 'b';
+  }
+
+  for (int i = 1; i != 10000; ++i)
+    interner.Intern("a_rather_long_client_name_" + std::to_string(i));
+
+  EXPECT_EQ(interner.GetName(0), "a_rather_long_client_name_0");
+  EXPECT_EQ(interner.Find("a_rather_long_client_name_0"), 0u);
+  EXPECT_EQ(interner.Find("a_rather_long_client_name_9999"), 9999u);
+}
+
+TEST(ClientNameInternerTest, ClearStartsNumberingAgain) {
+  ClientNameInterner interner;
+  interner.Intern("client1");
+  interner.Intern("client2");
+
+  interner.Clear();
+
+  EXPECT_EQ(interner.Size(), 0u);
+  EXPECT_EQ(interner.Find("client1"), kNoClient);
+  EXPECT_EQ(interner.Intern("client2"), 0u);
+}
+
+TEST(ClientNameInternerTest, ServesManyDays) {
+  ClientNameInterner interner;
+
+  for (int day = 0; day != 3; ++day) {
+    for (int i = 0; i != 5000; ++i)
+      EXPECT_EQ(interner.Intern("day" + std::to_string(day) + "_client" +
+                                std::to_string(i)),
+                static_cast<uint32_t>(i));
+
+    EXPECT_EQ(interner.GetName(4999),
+              "day" + std::to_string(day) + "_client4999");
+    interner.Clear();
+  }
+  EXPECT_EQ(interner.Find("day2_client0"), kNoClient);
+}
+
+}  // namespace
@@ -0,0 +1,87 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Radix sorting of clients by name testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "include/client_name_interner.h"
+#include "include/client_name_sorter.h"
+#include "include/cybercafe_monitoring_system.h"
+
+namespace {
+
+using cybercafe_monitoring_system::ClientId;
+using cybercafe_monitoring_system::ClientNameInterner;
+using cybercafe_monitoring_system::ClientNameSorter;
+using cybercafe_monitoring_system::CybercafeMonitoringSystem;
+
+// Names as sorted by the sorter
+std::vector<std::string_view> SortNames(ClientNameSorter& sorter,
+                                        const ClientNameInterner& interner) {
+  std::vector<ClientId> clients(interner.Size());
+  for (ClientId client = 0; client != clients.size(); ++client)
+    clients[client] = client;
+
+  sorter.Sort(clients, interner);
+
+  std::vector<std::string_view> names;
+  for (ClientId client : clients) names.push_back(interner.GetName(client));
+  return names;
+}
+
+TEST(ClientNameSorterTest, FollowsNameAlphabet) {
+  ClientNameInterner interner;
+  for (std::string_view name : {"b", "a-", "a_", "a9", "a0", "az", "a", "ab"})
+    interner.Intern(name);
+
+  ClientNameSorter sorter;
+  EXPECT_EQ(SortNames(sorter, interner),
+            (std::vector<std::string_view>{"a", "ab", "az", "a0", "a9", "a_",
+                                           "a-", "b"}));
+}
+
+TEST(ClientNameSorterTest, MatchesClientsNameCompare) {
+  constexpr std::string_view kAlphabet =
+      "abcdefghijklmnopqrstuvwxyz0123456789_-";
+  std::mt19937 random(7);
+  std::uniform_int_distribution<size_t> character(0, kAlphabet.size() - 1);
+  std::uniform_int_distribution<int> length(1, 12);
+
+  // Few leading characters make long shared prefixes and deep recursion
+  ClientNameInterner interner;
+  for (int i = 0; i != 20000; ++i) {
+    std::string name(static_cast<size_t>(length(random)), 'c');
+    for (size_t j = 2; j < name.size(); ++j)
+      name[j] = kAlphabet[character(random)];
+    interner.Intern(name);
+  }
+
+  std::vector<std::string_view> expected;
+  for (ClientId client = 0; client != interner.Size(); ++client)
+    expected.push_back(interner.GetName(client));
+  std::ranges::sort(expected, CybercafeMonitoringSystem::ClientsNameCompare{});
+
+  ClientNameSorter sorter;
+  EXPECT_EQ(SortNames(sorter, interner), expected);
+
+  // The buffers left from the first call do not leak into the second
+  ClientNameInterner few;
+  few.Intern("zz");
+  few.Intern("c");
+  EXPECT_EQ(SortNames(sorter, few),
+            (std::vector<std::string_view>{"c", "zz"}));
+}
+
+}  // namespace
@@ -0,0 +1,106 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Client name validation testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "include/client_name_validator.h"
+
+namespace {
+
+using cybercafe_monitoring_system::AreClientNameCharactersValid;
+using cybercafe_monitoring_system::GetClientNameCharacterKey;
+using cybercafe_monitoring_system::GetCommonPrefixSize;
+using cybercafe_monitoring_system::GetSupportedSimdLevel;
+using cybercafe_monitoring_system::IsClientNameValid;
+using cybercafe_monitoring_system::SimdLevel;
+
+constexpr std::string_view kAlphabet = "abcdefghijklmnopqrstuvwxyz0123456789_-";
+
+// Every level up to the supported one
+std::vector<SimdLevel> GetTestedLevels() {
+  std::vector<SimdLevel> levels = {SimdLevel::kScalar};
+  if (GetSupportedSimdLevel() != SimdLevel::kScalar)
+    levels.push_back(SimdLevel::kSse2);
+  if (GetSupportedSimdLevel() == SimdLevel::kAvx2)
+    levels.push_back(SimdLevel::kAvx2);
+  return levels;
+}
+
+TEST(ClientNameValidatorTest, KeysFollowAlphabet) {
+  for (size_t i = 0; i != kAlphabet.size(); ++i)
+    EXPECT_EQ(GetClientNameCharacterKey(kAlphabet[i]), i + 1);
+
+  for (char c : std::string_view("AZ .:!\x7f\x80\xff"))
+    EXPECT_EQ(GetClientNameCharacterKey(c), 0);
+}
+
+TEST(ClientNameValidatorTest, ShortNames) {
+  EXPECT_TRUE(IsClientNameValid("client_1-a"));
+  EXPECT_FALSE(IsClientNameValid(""));
+  EXPECT_FALSE(IsClientNameValid("Client1"));
+  EXPECT_FALSE(IsClientNameValid("client 1"));
+}
+
+// Every level finds a single bad character at any position of names of any
+// length around the vector sizes
+TEST(ClientNameValidatorTest, LevelsAgreeOnEveryPosition) {
+  const std::string bad_characters("A@[`{/:\x7f\x80\xff\0 ", 13);
+
+  for (SimdLevel level : GetTestedLevels()) {
+    for (size_t size = 0; size <= 80; ++size) {
+      std::string name(size, 'a');
+      for (size_t i = 0; i != size; ++i) name[i] = kAlphabet[i % 38];
+      EXPECT_TRUE(AreClientNameCharactersValid(name, level)) << size;
+
+      for (size_t position = 0; position != size; ++position)
+        for (char bad : bad_characters) {
+          std::string bad_name = name;
+          bad_name[position] = bad;
+          EXPECT_FALSE(AreClientNameCharactersValid(bad_name, level))
+              << static_cast<int>(level) << " " << size << " " << position;
+        }
+    }
+  }
+}
+
+TEST(ClientNameValidatorTest, LongNamesUseDispatchedLevel) {
+  std::string name(100, 'z');
+  EXPECT_TRUE(IsClientNameValid(name));
+  name[99] = 'Z';
+  EXPECT_FALSE(IsClientNameValid(name));
+}
+
+TEST(ClientNameValidatorTest, CommonPrefixSize) {
+  std::mt19937 random(3);
+  std::uniform_int_distribution<size_t> size(0, 70);
+
+  for (int i = 0; i != 2000; ++i) {
+    std::string first(size(random), 'x');
+    std::string second = first.substr(0, size(random) % (first.size() + 1));
+    size_t expected = second.size();
+    if (not second.empty() and i % 2 == 0) {
+      expected = size(random) % second.size();
+      second[expected] = 'y';
+    }
+    second += "tail";
+
+    EXPECT_EQ(GetCommonPrefixSize(first, second),
+              std::min(expected, first.size()));
+    EXPECT_EQ(GetCommonPrefixSize(second, first),
+              std::min(expected, first.size()));
+  }
+}
+
+}  // namespace
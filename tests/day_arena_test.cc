@@ -0,0 +1,79 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Day arena testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/day_arena.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace {
+
+using cybercafe_monitoring_system::DayArena;
+
+// Counts what goes to the default resource
+class CountingResource final : public std::pmr::memory_resource {
+ public:
+  size_t allocations = 0;
+
+  size_t deallocations = 0;
+
+ private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* data, size_t bytes, size_t alignment) override {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(data, bytes, alignment);
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+TEST(DayArenaTest, KeepsAlignmentAndGrows) {
+  CountingResource upstream;
+  DayArena arena(64, &upstream);
+
+  for (size_t alignment : {1, 2, 8, 16, 64, 256}) {
+    void* data = arena.allocate(40, alignment);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(data) % alignment, 0u) << alignment;
+  }
+  void* large = arena.allocate(1000, 8);
+  EXPECT_NE(large, nullptr);
+  EXPECT_GE(arena.GetCapacity(), 1000u + 6 * 40);
+  EXPECT_EQ(upstream.deallocations, 0u);
+}
+
+TEST(DayArenaTest, ResetReusesTheBlocks) {
+  CountingResource upstream;
+  {
+    DayArena arena(256, &upstream);
+
+    for (int day = 0; day != 3; ++day) {
+      for (int i = 0; i != 10000; ++i)
+        EXPECT_NE(arena.allocate(24, 8), nullptr);
+      arena.Reset();
+      if (day == 0) upstream.allocations = 0;
+    }
+
+    EXPECT_EQ(upstream.allocations, 0u);
+    EXPECT_EQ(upstream.deallocations, 0u);
+  }
+  EXPECT_NE(upstream.deallocations, 0u);
+}
+
+}  // namespace
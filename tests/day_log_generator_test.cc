@@ -0,0 +1,101 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Synthetic day log generator testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <sstream>
+#include <string>
+
+#include "include/day_log_generator.h"
+#include "include/output_sink.h"
+#include "include/read_input_data.h"
+
+namespace {
+
+using cybercafe_monitoring_system::ArrivalDistribution;
+using cybercafe_monitoring_system::DayLogOptions;
+using cybercafe_monitoring_system::GenerateDayLog;
+using cybercafe_monitoring_system::MemoryOutputSink;
+
+std::string Generate(const DayLogOptions& options) {
+  MemoryOutputSink output;
+  GenerateDayLog(options, output);
+  return std::string(output.View());
+}
+
+// Output of the system for the log
+std::string Process(const std::string& log) {
+  std::istringstream in(log);
+  MemoryOutputSink output;
+  cybercafe_monitoring_system_test::ProcessingInputData(in, output);
+  return std::string(output.View());
+}
+
+TEST(DayLogGeneratorTest, SameSeedSameLog) {
+  DayLogOptions options{.seed = 7, .events_count = 5000};
+
+  EXPECT_EQ(Generate(options), Generate(options));
+
+  options.seed = 8;
+  DayLogOptions other = options;
+  other.seed = 9;
+  EXPECT_NE(Generate(options), Generate(other));
+}
+
+TEST(DayLogGeneratorTest, LogIsValidAndErrorFree) {
+  DayLogOptions options{.seed = 3,
+                        .tables_count = 20,
+                        .events_count = 20000,
+                        .arrivals = ArrivalDistribution::kRushHour,
+                        .error_ratio = 0};
+
+  MemoryOutputSink log;
+  const uint64_t events = GenerateDayLog(options, log);
+  EXPECT_GT(events, 15000u);
+  EXPECT_LT(events, 25000u);
+
+  const std::string output = Process(std::string(log.View()));
+  EXPECT_EQ(output.find(" 13 "), std::string::npos);
+  EXPECT_NE(output.find(" 12 "), std::string::npos);
+}
+
+TEST(DayLogGeneratorTest, ErrorRatioIsRoughlyKept) {
+  DayLogOptions options{.seed = 5, .events_count = 20000, .error_ratio = 0.1};
+
+  const std::string log = Generate(options);
+  const std::string output = Process(log);
+
+  size_t events = 0, errors = 0;
+  std::istringstream lines(output);
+  for (std::string line; std::getline(lines, line);) {
+    events += line.find(" 1 ") != std::string::npos;
+    errors += line.find(" 13 ") != std::string::npos;
+  }
+  EXPECT_GT(errors, 0u);
+  EXPECT_LT(errors, events);
+}
+
+TEST(DayLogGeneratorTest, WritesVenueDays) {
+  const auto dir =
+      std::filesystem::temp_directory_path() / "cybercafe_generator_tests";
+  DayLogOptions options{.events_count = 100};
+
+  auto paths = cybercafe_monitoring_system::GenerateVenueDays(options, 3, 2,
+                                                              dir);
+
+  ASSERT_EQ(paths.size(), 6u);
+  EXPECT_EQ(paths[1].filename(), "venue000_day001.txt");
+  for (const auto& path : paths) EXPECT_TRUE(std::filesystem::exists(path));
+
+  std::filesystem::remove_all(dir);
+}
+
+}  // namespace
@@ -510,4 +510,134 @@ TEST_F(CybercafeMonitoringSystemTest, LeavingNonExistentClient) {
   leave_event.Handle(*system);  // Should generate "ClientUnknown"
 }
 
+TEST_F(CybercafeMonitoringSystemTest, TableOccupantLookup) {
+  TimePoint event_time = TimePoint{minutes{12 * 60}};
+
+  EXPECT_EQ(system->FindFirstFreeTable(), 1);
+
+  ClientArrivedEvent(event_time, "client1").Handle(*system);
+  ClientSatAtTableEvent(event_time, "client1", 1, Event::Type::kIncoming)
+      .Handle(*system);
+  ClientArrivedEvent(event_time, "client2").Handle(*system);
+  ClientSatAtTableEvent(event_time, "client2", 3, Event::Type::kIncoming)
+      .Handle(*system);
+
+  EXPECT_EQ(system->GetTableOccupant(1), "client1");
+  EXPECT_TRUE(system->GetTableOccupant(2).empty());
+  EXPECT_EQ(system->GetTableOccupant(3), "client2");
+  EXPECT_EQ(system->FindFirstFreeTable(), 2);
+  EXPECT_THROW(system->GetTableOccupant(tables_count + 1),
+               std::invalid_argument);
+
+  ClientSatAtTableEvent(event_time, "client1", 2, Event::Type::kIncoming)
+      .Handle(*system);
+  EXPECT_TRUE(system->GetTableOccupant(1).empty());
+  EXPECT_EQ(system->GetTableOccupant(2), "client1");
+  EXPECT_EQ(system->FindFirstFreeTable(), 1);
+}
+
+TEST_F(CybercafeMonitoringSystemTest, RepeatedWaitKeepsSinglePlace) {
+  TimePoint event_time = TimePoint{minutes{12 * 60}};
+
+  for (int i = 1; i <= tables_count; ++i) {
+    std::string client = "client" + std::to_string(i);
+    ClientArrivedEvent(event_time, client).Handle(*system);
+    ClientSatAtTableEvent(event_time, client, i, Event::Type::kIncoming)
+        .Handle(*system);
+  }
+
+  ClientArrivedEvent(event_time, "first").Handle(*system);
+  ClientWaitingEvent(event_time, "first").Handle(*system);
+  ClientArrivedEvent(event_time, "second").Handle(*system);
+  ClientWaitingEvent(event_time, "second").Handle(*system);
+  ClientWaitingEvent(event_time, "first").Handle(*system);
+
+  ClientLeftEvent(event_time, "client1", Event::Type::kIncoming)
+      .Handle(*system);
+  EXPECT_EQ(system->GetTableOccupant(1), "first");
+
+  ClientLeftEvent(event_time, "client2", Event::Type::kIncoming)
+      .Handle(*system);
+  EXPECT_EQ(system->GetTableOccupant(2), "second");
+
+  ClientLeftEvent(event_time, "client3", Event::Type::kIncoming)
+      .Handle(*system);
+  EXPECT_TRUE(system->IsTableFree(3));
+}
+
+TEST_F(CybercafeMonitoringSystemTest, WaitingClientLeavesQueue) {
+  TimePoint event_time = TimePoint{minutes{12 * 60}};
+
+  for (int i = 1; i <= tables_count; ++i) {
+    std::string client = "client" + std::to_string(i);
+    ClientArrivedEvent(event_time, client).Handle(*system);
+    ClientSatAtTableEvent(event_time, client, i, Event::Type::kIncoming)
+        .Handle(*system);
+  }
+
+  for (const char* client : {"first", "second", "third"}) {
+    ClientArrivedEvent(event_time, client).Handle(*system);
+    ClientWaitingEvent(event_time, client).Handle(*system);
+  }
+
+  ClientLeftEvent(event_time, "second", Event::Type::kIncoming)
+      .Handle(*system);
+  ClientLeftEvent(event_time, "client1", Event::Type::kIncoming)
+      .Handle(*system);
+  ClientLeftEvent(event_time, "client2", Event::Type::kIncoming)
+      .Handle(*system);
+
+  EXPECT_EQ(system->GetTableOccupant(1), "first");
+  EXPECT_EQ(system->GetTableOccupant(2), "third");
+}
+
+TEST_F(CybercafeMonitoringSystemTest, EventRecordsMatchEventClasses) {
+  using cybercafe_monitoring_system::MemoryOutputSink;
+
+  MemoryOutputSink class_output, record_output;
+  CybercafeMonitoringSystem class_system(opening_time, closing_time,
+                                         tables_count, hourly_rate,
+                                         class_output);
+  CybercafeMonitoringSystem record_system(opening_time, closing_time,
+                                          tables_count, hourly_rate,
+                                          record_output);
+  TimePoint event_time = TimePoint{minutes{12 * 60}};
+
+  class_system.StartWorkDayTrigger();
+  ClientArrivedEvent(event_time, "client1").Handle(class_system);
+  ClientSatAtTableEvent(event_time, "client1", 2, EventType::kIncoming)
+      .Handle(class_system);
+  ClientWaitingEvent(event_time, "client2").Handle(class_system);
+  ClientLeftEvent(event_time, "client1", EventType::kIncoming)
+      .Handle(class_system);
+  class_system.EndWorkDayTrigger();
+
+  record_system.StartWorkDayTrigger();
+  record_system.Handle(
+      record_system.MakeEventRecord(event_time, EventId::k1, "client1"));
+  record_system.Handle(
+      record_system.MakeEventRecord(event_time, EventId::k2, "client1", 2));
+  record_system.Handle(
+      record_system.MakeEventRecord(event_time, EventId::k3, "client2"));
+  record_system.Handle(
+      record_system.MakeEventRecord(event_time, EventId::k4, "client1"));
+  record_system.EndWorkDayTrigger();
+
+  EXPECT_EQ(record_output.View(), class_output.View());
+}
+
+TEST_F(CybercafeMonitoringSystemTest, EventRecordRejectsBadInput) {
+  TimePoint event_time = TimePoint{minutes{12 * 60}};
+
+  EXPECT_EQ(sizeof(CybercafeMonitoringSystem::EventRecord), 16u);
+  EXPECT_THROW(system->MakeEventRecord(event_time, EventId::k1, "Client"),
+               std::invalid_argument);
+  EXPECT_THROW(system->MakeEventRecord(event_time, EventId::k11, "client"),
+               std::invalid_argument);
+
+  auto record = system->MakeEventRecord(event_time, EventId::k3, "client", 5);
+  EXPECT_EQ(record.minutes, 12 * 60);
+  EXPECT_EQ(record.table_id, 0);
+}
+
 }  // namespace
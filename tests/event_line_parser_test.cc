@@ -0,0 +1,148 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Allocation-free input parsing and memory mapped reading testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#include "include/cybercafe_monitoring_system.h"
+#include "include/event_line_parser.h"
+#include "include/mapped_file.h"
+#include "include/output_sink.h"
+#include "include/read_input_data.h"
+#include "tests/processing_test_helpers.h"
+
+namespace {
+
+using cybercafe_monitoring_system::ParseEventLine;
+using cybercafe_monitoring_system::ParseTime;
+using cybercafe_monitoring_system::TimePoint;
+using Id = cybercafe_monitoring_system::CybercafeMonitoringSystem::Event::Id;
+
+TEST(EventLineParserTest, ParsesAllIncomingEvents) {
+  auto arrived = ParseEventLine("08:48 1 client1");
+  EXPECT_EQ(arrived.time, TimePoint{std::chrono::minutes{8 * 60 + 48}});
+  EXPECT_EQ(arrived.id, Id::k1);
+  EXPECT_EQ(arrived.client_name, "client1");
+
+  auto sat = ParseEventLine("09:54 2 client1 12");
+  EXPECT_EQ(sat.id, Id::k2);
+  EXPECT_EQ(sat.client_name, "client1");
+  EXPECT_EQ(sat.table_id, 12);
+
+  EXPECT_EQ(ParseEventLine("09:52 3 client1").id, Id::k3);
+  EXPECT_EQ(ParseEventLine("12:33 4 client1").id, Id::k4);
+}
+
+TEST(EventLineParserTest, ToleratesExtraWhitespace) {
+  auto sat = ParseEventLine("  09:54\t2   client1 1\r");
+  EXPECT_EQ(sat.client_name, "client1");
+  EXPECT_EQ(sat.table_id, 1);
+}
+
+TEST(EventLineParserTest, RejectsIncorrectLines) {
+  EXPECT_THROW(ParseEventLine(""), std::invalid_argument);
+  EXPECT_THROW(ParseEventLine("9:54 1 client1"), std::invalid_argument);
+  EXPECT_THROW(ParseEventLine("24:00 1 client1"), std::invalid_argument);
+  EXPECT_THROW(ParseEventLine("09:60 1 client1"), std::invalid_argument);
+  EXPECT_THROW(ParseEventLine("09:54 x client1"), std::invalid_argument);
+  EXPECT_THROW(ParseEventLine("09:54 5 client1"), std::invalid_argument);
+  EXPECT_THROW(ParseEventLine("09:54 11 client1"), std::invalid_argument);
+  EXPECT_THROW(ParseEventLine("09:54 1"), std::invalid_argument);
+  EXPECT_THROW(ParseEventLine("09:54 2 client1"), std::invalid_argument);
+  EXPECT_THROW(ParseEventLine("09:54 2 client1 1x"), std::invalid_argument);
+}
+
+TEST(EventLineParserTest, ParseTimeBoundaries) {
+  EXPECT_EQ(ParseTime("00:00"), TimePoint{std::chrono::minutes{0}});
+  EXPECT_EQ(ParseTime("23:59"), TimePoint{std::chrono::minutes{1439}});
+  EXPECT_THROW(ParseTime("ab:cd"), std::invalid_argument);
+}
+
+class MappedInputTest : public cybercafe_monitoring_system_test::TempDirTest {
+ protected:
+  template <typename Run>
+  static std::string CaptureOutput(Run&& run) {
+    cybercafe_monitoring_system::MemoryOutputSink output;
+    run(output);
+    return std::string(output.View());
+  }
+};
+
+TEST_F(MappedInputTest, MapsWholeFile) {
+  auto file_path = CreateFile("mapped.txt", "abc\ndef");
+
+  cybercafe_monitoring_system::MappedFile mapped_file(file_path);
+  EXPECT_EQ(mapped_file.View(), "abc\ndef");
+
+  cybercafe_monitoring_system::MappedFile moved = std::move(mapped_file);
+  EXPECT_EQ(moved.Size(), 7u);
+  EXPECT_EQ(mapped_file.Size(), 0u);
+}
+
+TEST_F(MappedInputTest, MissingFileThrows) {
+  EXPECT_THROW(cybercafe_monitoring_system::MappedFile(temp_dir / "missing"),
+               std::runtime_error);
+}
+
+TEST_F(MappedInputTest, MatchesStreamReader) {
+  auto file_path = CreateFile("day.txt",
+                                  "3\n"
+                                  "09:00 19:00\n"
+                                  "10\n"
+                                  "08:48 1 client1\n"
+                                  "09:41 1 client1\n"
+                                  "09:48 1 client2\n"
+                                  "09:52 3 client1\n"
+                                  "09:54 2 client1 1\n"
+                                  "10:25 2 client2 2\n"
+                                  "10:58 1 client3\n"
+                                  "10:59 2 client3 3\n"
+                                  "11:30 1 client4\n"
+                                  "11:35 2 client4 2\n"
+                                  "11:45 3 client4\n"
+                                  "12:33 4 client1\n"
+                                  "12:43 4 client2\n"
+                                  "15:52 4 client4\n");
+
+  std::string stream_output = CaptureOutput([&](auto& output) {
+    std::ifstream in(file_path);
+    cybercafe_monitoring_system_test::ProcessingInputData(in, output);
+  });
+  std::string mapped_output = CaptureOutput([&](auto& output) {
+    cybercafe_monitoring_system_test::ProcessingMappedInputData(file_path,
+                                                                output);
+  });
+
+  EXPECT_EQ(stream_output, mapped_output);
+}
+
+TEST_F(MappedInputTest, ReportsIncorrectLine) {
+  auto file_path = CreateFile("bad.txt",
+                                  "3\n"
+                                  "09:00 19:00\n"
+                                  "10\n"
+                                  "09:48 1 client2\n"
+                                  "09:52 2 client2\n");
+
+  try {
+    CaptureOutput([&](auto& output) {
+      cybercafe_monitoring_system_test::ProcessingMappedInputData(file_path,
+                                                                  output);
+    });
+    FAIL() << "Expected std::runtime_error";
+  } catch (const std::runtime_error& e) {
+    EXPECT_STREQ(e.what(), "09:52 2 client2");
+  }
+}
+
+}  // namespace
@@ -0,0 +1,136 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Pipelined event handling testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/event_pipeline.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "include/cybercafe_monitoring_system.h"
+#include "include/day_log_generator.h"
+#include "include/event_line_parser.h"
+#include "include/output_sink.h"
+#include "include/read_input_data.h"
+#include "tests/processing_test_helpers.h"
+
+namespace {
+
+using cybercafe_monitoring_system::CybercafeMonitoringSystem;
+using cybercafe_monitoring_system::EventPipelineOptions;
+using cybercafe_monitoring_system::MemoryOutputSink;
+using cybercafe_monitoring_system::TimePoint;
+using cybercafe_monitoring_system_test::RunProcessing;
+
+// README sample input
+constexpr std::string_view kDay =
+    "3\n"
+    "09:00 19:00\n"
+    "10\n"
+    "08:48 1 client1\n"
+    "09:41 1 client1\n"
+    "09:48 1 client2\n"
+    "09:52 3 client1\n"
+    "09:54 2 client1 1\n"
+    "10:25 2 client2 2\n"
+    "10:58 1 client3\n"
+    "10:59 2 client3 3\n"
+    "11:30 1 client4\n"
+    "11:35 2 client4 2\n"
+    "11:45 3 client4\n"
+    "12:33 4 client1\n"
+    "12:43 4 client2\n"
+    "15:52 4 client4\n";
+
+class EventPipelineTest
+    : public cybercafe_monitoring_system_test::TempDirTest {
+ protected:
+  // The pipelined and the single-threaded processing of the file agree
+  static void ExpectSameAsMapped(const std::filesystem::path& file_path) {
+    const auto mapped = RunProcessing([&](MemoryOutputSink& output) {
+      cybercafe_monitoring_system_test::ProcessingMappedInputData(file_path,
+                                                                  output);
+    });
+    const auto pipelined = RunProcessing([&](MemoryOutputSink& output) {
+      cybercafe_monitoring_system_test::ProcessingPipelinedInputData(
+          file_path, output);
+    });
+    EXPECT_EQ(pipelined, mapped);
+  }
+};
+
+TEST_F(EventPipelineTest, MatchesMappedProcessing) {
+  ExpectSameAsMapped(CreateFile("readme.txt", kDay));
+
+  // Several blocks with errors, waiting clients and clients left at closing
+  cybercafe_monitoring_system::DayLogOptions options;
+  options.events_count = 30000;
+  options.error_ratio = 0.05;
+  {
+    cybercafe_monitoring_system::FileOutputSink log(temp_dir / "day.txt");
+    cybercafe_monitoring_system::GenerateDayLog(options, log);
+  }
+  ExpectSameAsMapped(temp_dir / "day.txt");
+}
+
+TEST_F(EventPipelineTest, AnyBlockSizeGivesTheSameOutput) {
+  std::string_view text = kDay;
+  for (int line = 0; line != 3; ++line)
+    cybercafe_monitoring_system::NextLine(text);
+
+  auto run = [&](const EventPipelineOptions& options) {
+    MemoryOutputSink output;
+    CybercafeMonitoringSystem system(
+        TimePoint{std::chrono::minutes{9 * 60}},
+        TimePoint{std::chrono::minutes{19 * 60}}, 3, 10, output);
+    system.StartWorkDayTrigger();
+
+    std::string_view file_line;
+    const auto result = cybercafe_monitoring_system::HandleEventsPipelined(
+        system, text, file_line, output, options);
+    EXPECT_EQ(result.events, 14u);
+    EXPECT_FALSE(result.order_violated);
+
+    system.EndWorkDayTrigger();
+    return std::string(output.View());
+  };
+
+  const std::string expected = run({});
+  for (size_t block_size : {1, 2, 5})
+    for (size_t blocks_in_flight : {1, 2, 3})
+      EXPECT_EQ(run({block_size, blocks_in_flight}), expected)
+          << block_size << " " << blocks_in_flight;
+}
+
+TEST_F(EventPipelineTest, ReportsIncorrectLine) {
+  const std::string header(kDay.substr(0, kDay.find("08:48")));
+
+  for (std::string_view events :
+       {"09:10 1 client1\n09:20 1 Client2\n09:30 1 client3\n",
+        "09:10 1 client1\n09:20 9 client2\n",
+        "09:10 1 client1\n09:2 1 client2\n",
+        "09:10 1 client1\n09:20 2 client1\n",
+        "09:10 1 client1\n09:05 1 client2\n09:20 1 client3\n"}) {
+    ExpectSameAsMapped(CreateFile("bad.txt", header + std::string(events)));
+  }
+
+  const auto [output, error] = RunProcessing([&](MemoryOutputSink& output) {
+    cybercafe_monitoring_system_test::ProcessingPipelinedInputData(
+        CreateFile("bad.txt", header + "09:10 1 client1\n09:20 1 Client2\n"),
+        output);
+  });
+  EXPECT_EQ(output, "09:00\n09:10 1 client1\n");
+  EXPECT_EQ(error, "09:20 1 Client2");
+}
+
+}  // namespace
@@ -13,48 +13,39 @@
 #include <filesystem>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 
 #include "include/cybercafe_monitoring_system.h"
+#include "include/output_sink.h"
 #include "include/read_input_data.h"
+#include "tests/processing_test_helpers.h"
 
 namespace {
 
-class CybercafeSystemTest : public ::testing::Test {
+class CybercafeSystemTest
+    : public cybercafe_monitoring_system_test::TempDirTest {
  protected:
-  void SetUp() override {
-    temp_dir = std::filesystem::temp_directory_path() / "cybercafe_tests";
-    std::filesystem::create_directory(temp_dir);
-  }
-
-  void TearDown() override { std::filesystem::remove_all(temp_dir); }
-
   void CreateTestFile(const std::string& filename, const std::string& content) const {
     std::ofstream out(temp_dir / filename);
     out << content;
     out.close();
   }
 
-  std::string RunSystemWithInput(const std::string& filename) const {
-    std::stringstream buffer;
-    std::streambuf* old = std::cout.rdbuf(buffer.rdbuf());
-
+  std::string RunSystemWithInput(
+      const std::string& filename,
+      cybercafe_monitoring_system_test::InputMode mode =
+          cybercafe_monitoring_system_test::InputMode::kBuffered) const {
     std::ifstream in(temp_dir / filename);
     if (!in.is_open()) {
       throw std::runtime_error("Cannot open test file");
     }
 
-    try {
-      cybercafe_monitoring_system_test::ProcessingInputData(in);
-    } catch (...) {
-      std::cout.rdbuf(old);
-      throw;
-    }
+    cybercafe_monitoring_system::MemoryOutputSink output;
+    cybercafe_monitoring_system_test::ProcessingInputData(in, output, mode);
 
-    std::cout.rdbuf(old);
-    return buffer.str();
+    return std::string(output.View());
   }
-
-  std::filesystem::path temp_dir;
 };
 
 TEST_F(CybercafeSystemTest, ValidInput) {
@@ -119,4 +110,142 @@ TEST_F(CybercafeSystemTest, InvalidTableCount) {
       { RunSystemWithInput("invalid_tables.txt"); }, std::runtime_error);
 }
 
+TEST_F(CybercafeSystemTest, StreamingMatchesBuffered) {
+  std::string input_content =
+      "3\n"
+      "09:00 19:00\n"
+      "10\n"
+      "08:48 1 client1\n"
+      "09:41 1 client1\n"
+      "09:48 1 client2\n"
+      "09:52 3 client1\n"
+      "09:54 2 client1 1\n"
+      "10:25 2 client2 2\n"
+      "11:35 2 client2 1\n"
+      "12:33 4 client1\n";
+
+  CreateTestFile("streaming.txt", input_content);
+
+  std::string buffered = RunSystemWithInput("streaming.txt");
+  std::string streamed = RunSystemWithInput(
+      "streaming.txt", cybercafe_monitoring_system_test::InputMode::kStreaming);
+
+  EXPECT_EQ(buffered, streamed);
+}
+
+TEST_F(CybercafeSystemTest, StreamingFromNonFileStream) {
+  std::istringstream input(
+      "1\n"
+      "08:00 20:00\n"
+      "10\n"
+      "08:15 1 client1\n"
+      "08:20 2 client1 1\n");
+
+  cybercafe_monitoring_system::MemoryOutputSink output;
+  EXPECT_NO_THROW(cybercafe_monitoring_system_test::ProcessingInputData(
+      input, output, cybercafe_monitoring_system_test::InputMode::kStreaming));
+
+  EXPECT_NE(output.View().find("20:00 11 client1"), std::string::npos);
+}
+
+TEST_F(CybercafeSystemTest, StreamingReportsIncorrectLine) {
+  std::string input_content =
+      "3\n"
+      "08:00 20:00\n"
+      "10\n"
+      "08:15 1 client1\n"
+      "08:16 1 Client@Invalid\n"
+      "08:17 1 client2\n";
+
+  CreateTestFile("streaming_invalid.txt", input_content);
+
+  try {
+    RunSystemWithInput("streaming_invalid.txt",
+                       cybercafe_monitoring_system_test::InputMode::kStreaming);
+    FAIL() << "Expected std::runtime_error";
+  } catch (const std::runtime_error& e) {
+    EXPECT_STREQ(e.what(), "08:16 1 Client@Invalid");
+  }
+}
+
+TEST_F(CybercafeSystemTest, ProcessingStatsCountEveryPhase) {
+  const std::string input_content =
+      "3\n"
+      "08:00 20:00\n"
+      "10\n"
+      "08:15 1 client1\n"
+      "08:20 2 client1 1\n"
+      "09:00 4 client1\n";
+
+  for (auto mode : {cybercafe_monitoring_system_test::InputMode::kBuffered,
+                    cybercafe_monitoring_system_test::InputMode::kStreaming}) {
+    std::istringstream input(input_content);
+    cybercafe_monitoring_system::NullOutputSink output;
+    cybercafe_monitoring_system_test::ProcessingStats stats;
+
+    cybercafe_monitoring_system_test::ProcessingInputData(input, output, mode,
+                                                          &stats);
+
+    EXPECT_EQ(stats.events, 3u);
+    EXPECT_GT(stats.read + stats.open + stats.handle + stats.close,
+              std::chrono::nanoseconds{0});
+  }
+}
+
+TEST_F(CybercafeSystemTest, EveryModeChecksOrderAgainstThePreviousEvent) {
+  CreateTestFile("middle_violation.txt",
+                 "3\n"
+                 "08:00 20:00\n"
+                 "10\n"
+                 "09:10 1 client1\n"
+                 "09:20 1 client2\n"
+                 "09:15 1 client3\n");
+  const std::filesystem::path file_path = temp_dir / "middle_violation.txt";
+
+  for (auto mode : {cybercafe_monitoring_system_test::InputMode::kBuffered,
+                    cybercafe_monitoring_system_test::InputMode::kStreaming})
+    EXPECT_THROW(RunSystemWithInput("middle_violation.txt", mode),
+                 cybercafe_monitoring_system_test::EventsOrderViolation);
+
+  cybercafe_monitoring_system::MemoryOutputSink output;
+  EXPECT_THROW(cybercafe_monitoring_system_test::ProcessingMappedInputData(
+                   file_path, output),
+               cybercafe_monitoring_system_test::EventsOrderViolation);
+  EXPECT_THROW(cybercafe_monitoring_system_test::ProcessingPipelinedInputData(
+                   file_path, output),
+               cybercafe_monitoring_system_test::EventsOrderViolation);
+  EXPECT_THROW(cybercafe_monitoring_system_test::ProcessingParallelInputData(
+                   file_path, output),
+               cybercafe_monitoring_system_test::EventsOrderViolation);
+}
+
+TEST_F(CybercafeSystemTest, EveryModeReadsTheSameGrammar) {
+  for (const std::string line :
+       {"08:20 2 client1 +1", "08:20 2 client1 2x", "08:20 5 client1",
+        "08:20 1"}) {
+    CreateTestFile("grammar.txt",
+                   "3\n08:00 20:00\n10\n08:15 1 client1\n" + line + "\n");
+
+    for (auto mode :
+         {cybercafe_monitoring_system_test::InputMode::kBuffered,
+          cybercafe_monitoring_system_test::InputMode::kStreaming}) {
+      try {
+        RunSystemWithInput("grammar.txt", mode);
+        ADD_FAILURE() << line;
+      } catch (const std::runtime_error& e) {
+        EXPECT_EQ(e.what(), line);
+      }
+    }
+
+    cybercafe_monitoring_system::MemoryOutputSink output;
+    try {
+      cybercafe_monitoring_system_test::ProcessingMappedInputData(
+          temp_dir / "grammar.txt", output);
+      ADD_FAILURE() << line;
+    } catch (const std::runtime_error& e) {
+      EXPECT_EQ(e.what(), line);
+    }
+  }
+}
+
 }  // namespace
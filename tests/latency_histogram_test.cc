@@ -0,0 +1,62 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Latency histogram testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "include/latency_histogram.h"
+
+namespace {
+
+using cybercafe_monitoring_system::LatencyHistogram;
+using std::chrono::nanoseconds;
+
+TEST(LatencyHistogramTest, EmptyHistogramReportsZero) {
+  LatencyHistogram histogram;
+
+  EXPECT_EQ(histogram.GetCount(), 0u);
+  EXPECT_EQ(histogram.Percentile(0.99), nanoseconds{0});
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+  LatencyHistogram histogram;
+  for (int i = 0; i != 8; ++i) histogram.Record(nanoseconds{i});
+
+  EXPECT_EQ(histogram.Percentile(0.0), nanoseconds{0});
+  EXPECT_EQ(histogram.Percentile(0.5), nanoseconds{3});
+  EXPECT_EQ(histogram.Percentile(1.0), nanoseconds{7});
+}
+
+TEST(LatencyHistogramTest, PercentilesStayWithinBucketError) {
+  LatencyHistogram histogram;
+  for (int i = 1; i <= 1000; ++i) histogram.Record(nanoseconds{i * 1000});
+
+  const auto p50 = histogram.Percentile(0.50).count();
+  const auto p99 = histogram.Percentile(0.99).count();
+  EXPECT_GE(p50, 500000);
+  EXPECT_LE(p50, 500000 + 500000 / 8);
+  EXPECT_GE(p99, 990000);
+  EXPECT_LE(p99, 990000 + 990000 / 8);
+}
+
+TEST(LatencyHistogramTest, MergeAddsCounts) {
+  LatencyHistogram fast, slow;
+  for (int i = 0; i != 99; ++i) fast.Record(nanoseconds{100});
+  slow.Record(nanoseconds{1000000});
+
+  fast.Merge(slow);
+
+  EXPECT_EQ(fast.GetCount(), 100u);
+  EXPECT_LT(fast.Percentile(0.99).count(), 1000);
+  EXPECT_GE(fast.Percentile(1.0).count(), 1000000);
+}
+
+}  // namespace
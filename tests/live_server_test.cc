@@ -0,0 +1,229 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Live event ingestion testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "include/cybercafe_monitoring_system.h"
+#include "include/live_server.h"
+#include "include/output_sink.h"
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace {
+
+using cybercafe_monitoring_system::CybercafeMonitoringSystem;
+using cybercafe_monitoring_system::LiveServer;
+using cybercafe_monitoring_system::LiveServerOptions;
+using cybercafe_monitoring_system::MemoryOutputSink;
+using cybercafe_monitoring_system::TimePoint;
+
+#ifdef __linux__
+
+TimePoint At(int hours, int minutes) {
+  return TimePoint(std::chrono::minutes{hours * 60 + minutes});
+}
+
+// Connected terminal end of the socket
+class Terminal final {
+ public:
+  explicit Terminal(const std::filesystem::path& socket_path)
+      : fd_(::socket(AF_UNIX, SOCK_STREAM, 0)) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, socket_path.c_str());
+    connected_ = ::connect(fd_, reinterpret_cast<const sockaddr*>(&address),
+                           sizeof(address)) == 0;
+  }
+
+  ~Terminal() { Close(); }
+
+  inline bool IsConnected() const { return connected_; }
+
+  inline bool Send(std::string_view text) {
+    return ::write(fd_, text.data(), text.size()) ==
+           static_cast<ssize_t>(text.size());
+  }
+
+  inline void Close() {
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+  }
+
+ private:
+  int fd_;
+
+  bool connected_ = false;
+};
+
+class LiveServerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    socket_path = std::filesystem::temp_directory_path() /
+                  ("cybercafe_live_" + std::to_string(::getpid()) + ".sock");
+    options.socket_path = socket_path;
+    options.clock = [this] { return now; };
+  }
+
+  // Polls until the expected number of events is handled or rejected
+  void PollUntil(LiveServer& server, uint64_t events) {
+    for (int i = 0; i != 100; ++i) {
+      const auto& stats = server.GetStats();
+      if (stats.handled_events + stats.rejected_events >= events) return;
+      server.Poll(std::chrono::milliseconds{20});
+    }
+  }
+
+  std::filesystem::path socket_path;
+
+  LiveServerOptions options;
+
+  TimePoint now = At(8, 0);
+
+  MemoryOutputSink output;
+
+  CybercafeMonitoringSystem system{At(9, 0), At(19, 0), 3, 10, output};
+};
+
+TEST_F(LiveServerTest, ClockOpensAndClosesTheDay) {
+  LiveServer server(system, options);
+  server.Poll(std::chrono::milliseconds{0});
+  EXPECT_FALSE(server.IsDayOpen());
+  EXPECT_EQ(output.View(), "");
+
+  now = At(9, 0);
+  server.Poll(std::chrono::milliseconds{0});
+  EXPECT_TRUE(server.IsDayOpen());
+  EXPECT_EQ(output.View(), "09:00\n");
+
+  now = At(19, 0);
+  server.Poll(std::chrono::milliseconds{0});
+  EXPECT_FALSE(server.IsDayOpen());
+  EXPECT_EQ(output.View(), "09:00\n19:00\n1 0 00:00\n2 0 00:00\n3 0 00:00");
+}
+
+TEST_F(LiveServerTest, LinesAreHandledAsTheyArrive) {
+  now = At(10, 0);
+  LiveServer server(system, options);
+  Terminal terminal(socket_path);
+  ASSERT_TRUE(terminal.IsConnected());
+
+  ASSERT_TRUE(terminal.Send("09:30 1 client1\n1 client2\n"));
+  PollUntil(server, 2);
+  EXPECT_EQ(output.View(), "09:00\n09:30 1 client1\n10:00 1 client2\n");
+
+  // A partial line waits for the rest of it
+  ASSERT_TRUE(terminal.Send("10:05 2 client1 "));
+  server.Poll(std::chrono::milliseconds{20});
+  ASSERT_TRUE(terminal.Send("2\r\n"));
+  PollUntil(server, 3);
+
+  const auto& stats = server.GetStats();
+  EXPECT_EQ(stats.handled_events, 3u);
+  EXPECT_EQ(stats.latency.GetCount(), 3u);
+  EXPECT_GT(stats.latency.Percentile(0.99).count(), 0);
+  EXPECT_EQ(output.View(),
+            "09:00\n09:30 1 client1\n10:00 1 client2\n10:05 2 client1 2\n");
+}
+
+TEST_F(LiveServerTest, BadLinesAreRejected) {
+  now = At(10, 0);
+  LiveServer server(system, options);
+  Terminal terminal(socket_path);
+  ASSERT_TRUE(terminal.IsConnected());
+
+  ASSERT_TRUE(terminal.Send(
+      "09:30 1 client1\n09:00 1 client2\n1 Client3\n7 client4\nnonsense\n"
+      "09:40 4 client1\n"));
+  PollUntil(server, 6);
+
+  EXPECT_EQ(server.GetStats().handled_events, 2u);
+  EXPECT_EQ(server.GetStats().rejected_events, 4u);
+  EXPECT_EQ(output.View(), "09:00\n09:30 1 client1\n09:40 4 client1\n");
+}
+
+TEST_F(LiveServerTest, ConnectionIsPausedWhileBehind) {
+  now = At(10, 0);
+  options.max_lines_per_wakeup = 1;
+  options.max_connection_buffer = 32;
+  LiveServer server(system, options);
+  Terminal terminal(socket_path);
+  ASSERT_TRUE(terminal.IsConnected());
+
+  std::string lines;
+  for (int i = 0; i != 20; ++i)
+    lines += std::string(i % 2 == 0 ? "1" : "4") + " client\n";
+  ASSERT_TRUE(terminal.Send(lines));
+  terminal.Close();
+  PollUntil(server, 20);
+
+  EXPECT_EQ(server.GetStats().handled_events, 20u);
+  EXPECT_GT(server.GetStats().paused_connections, 0u);
+}
+
+TEST_F(LiveServerTest, FullConnectionsWaitForTheSharedBudget) {
+  now = At(10, 0);
+  options.max_lines_per_wakeup = 1;
+  options.max_connection_buffer = 32;
+  LiveServer server(system, options);
+  Terminal first(socket_path), second(socket_path);
+  ASSERT_TRUE(first.IsConnected());
+  ASSERT_TRUE(second.IsConnected());
+
+  // Both buffers fill up before a single line is handled
+  std::string first_lines, second_lines;
+  for (int i = 0; i != 10; ++i) {
+    first_lines += std::string(i % 2 == 0 ? "1" : "4") + " first\n";
+    second_lines += std::string(i % 2 == 0 ? "1" : "4") + " second\n";
+  }
+  ASSERT_TRUE(first.Send(first_lines));
+  ASSERT_TRUE(second.Send(second_lines));
+  first.Close();
+  second.Close();
+  PollUntil(server, 20);
+
+  EXPECT_EQ(server.GetStats().handled_events, 20u);
+  EXPECT_EQ(server.GetStats().rejected_events, 0u);
+}
+
+TEST_F(LiveServerTest, StopEndsRunAndClosesTheDay) {
+  now = At(10, 0);
+  {
+    LiveServer server(system, options);
+    EXPECT_TRUE(server.Poll(std::chrono::milliseconds{0}));
+    EXPECT_TRUE(server.IsDayOpen());
+
+    server.Stop();
+    server.Run();
+    EXPECT_FALSE(server.IsDayOpen());
+    EXPECT_FALSE(server.Poll(std::chrono::milliseconds{0}));
+  }
+
+  EXPECT_EQ(output.View(), "09:00\n19:00\n1 0 00:00\n2 0 00:00\n3 0 00:00");
+  EXPECT_FALSE(std::filesystem::exists(socket_path));
+}
+
+#else
+
+TEST(LiveServerTest, NeedsLinux) { GTEST_SKIP(); }
+
+#endif
+
+}  // namespace
@@ -0,0 +1,125 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Per-minute occupancy timeline testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/occupancy_timeline.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "include/cybercafe_monitoring_system.h"
+#include "include/event_line_parser.h"
+#include "include/output_sink.h"
+
+namespace {
+
+using cybercafe_monitoring_system::CybercafeMonitoringSystem;
+using cybercafe_monitoring_system::MinuteSeries;
+using cybercafe_monitoring_system::NullOutputSink;
+using cybercafe_monitoring_system::TimePoint;
+
+constexpr int32_t kDay = MinuteSeries::kMinutesPerDay;
+
+// README sample day
+constexpr std::string_view kEvents[] = {
+    "08:48 1 client1",   "09:41 1 client1",   "09:48 1 client2",
+    "09:52 3 client1",   "09:54 2 client1 1", "10:25 2 client2 2",
+    "10:58 1 client3",   "10:59 2 client3 3", "11:30 1 client4",
+    "11:35 2 client4 2", "11:45 3 client4",   "12:33 4 client1",
+    "12:43 4 client2",   "15:52 4 client4",
+};
+
+int32_t Minutes(int hours, int minutes) { return hours * 60 + minutes; }
+
+TEST(MinuteSeriesTest, RangeQueriesMatchRescan) {
+  std::mt19937 random(7);
+  std::uniform_int_distribution<int32_t> minute(0, kDay - 1);
+  std::uniform_int_distribution<int32_t> delta(-3, 5);
+
+  MinuteSeries series;
+  std::vector<int32_t> counts(kDay);
+  for (int round = 0; round != 3; ++round) {
+    for (int i = 0; i != 200; ++i) {
+      const int32_t from = minute(random), change = delta(random);
+      series.Add(from, change);
+      for (int32_t m = from; m != kDay; ++m) counts[m] += change;
+    }
+
+    for (int i = 0; i != 500; ++i) {
+      int32_t from = minute(random), to = minute(random) + 1;
+      if (from >= to) std::swap(from, to), ++to;
+      from = std::min(from, to - 1);
+
+      const auto begin = counts.begin() + from, end = counts.begin() + to;
+      EXPECT_EQ(series.GetPeak(from, to), *std::max_element(begin, end));
+      EXPECT_DOUBLE_EQ(series.GetAverage(from, to),
+                       static_cast<double>(std::accumulate(begin, end, 0)) /
+                           (to - from));
+    }
+    EXPECT_EQ(series.GetAt(kDay - 1), counts.back());
+  }
+}
+
+TEST(MinuteSeriesTest, ResetAndBadRanges) {
+  MinuteSeries series;
+  series.Add(10, 4);
+  EXPECT_EQ(series.GetPeak(0, kDay), 4);
+
+  series.Reset();
+  EXPECT_EQ(series.GetPeak(0, kDay), 0);
+  EXPECT_EQ(series.GetAverage(0, kDay), 0);
+
+  EXPECT_THROW(series.GetPeak(5, 5), std::invalid_argument);
+  EXPECT_THROW(series.GetAverage(-1, 5), std::invalid_argument);
+  EXPECT_THROW(series.GetAt(kDay), std::invalid_argument);
+}
+
+TEST(OccupancyTimelineTest, FollowsTheDay) {
+  NullOutputSink output;
+  CybercafeMonitoringSystem system(
+      TimePoint{std::chrono::minutes{Minutes(9, 0)}},
+      TimePoint{std::chrono::minutes{Minutes(19, 0)}}, 3, 10, output);
+
+  system.StartWorkDayTrigger();
+  for (std::string_view line : kEvents) {
+    auto parsed = cybercafe_monitoring_system::ParseEventLine(line);
+    system.Handle(system.MakeEventRecord(parsed.time, parsed.id,
+                                         parsed.client_name, parsed.table_id));
+  }
+  system.EndWorkDayTrigger();
+
+  const auto& occupied = system.GetOccupancyTimeline().GetOccupiedTables();
+  const auto& waiting = system.GetOccupancyTimeline().GetWaitingClients();
+
+  EXPECT_EQ(occupied.GetAt(Minutes(9, 53)), 0);
+  EXPECT_EQ(occupied.GetAt(Minutes(9, 54)), 1);
+  EXPECT_EQ(occupied.GetAt(Minutes(12, 33)), 3);
+  EXPECT_EQ(occupied.GetAt(Minutes(12, 43)), 2);
+  EXPECT_EQ(occupied.GetAt(Minutes(18, 59)), 1);
+  EXPECT_EQ(occupied.GetAt(Minutes(19, 0)), 0);
+  EXPECT_EQ(occupied.GetPeak(0, kDay), 3);
+
+  // 25 minutes of 1 table, 34 of 2 and 1 of 3
+  EXPECT_DOUBLE_EQ(occupied.GetAverage(Minutes(10, 0), Minutes(11, 0)), 1.6);
+
+  EXPECT_EQ(waiting.GetAt(Minutes(11, 45)), 1);
+  EXPECT_EQ(waiting.GetAt(Minutes(12, 33)), 0);
+  EXPECT_EQ(waiting.GetPeak(0, kDay), 1);
+  EXPECT_DOUBLE_EQ(waiting.GetAverage(Minutes(11, 45), Minutes(12, 33)), 1);
+}
+
+}  // namespace
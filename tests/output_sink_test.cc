@@ -0,0 +1,142 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Output sinks testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "include/cybercafe_monitoring_system.h"
+#include "include/output_sink.h"
+#include "tests/processing_test_helpers.h"
+
+namespace {
+
+using cybercafe_monitoring_system::CybercafeMonitoringSystem;
+using cybercafe_monitoring_system::TimePoint;
+using std::chrono::minutes;
+
+class OutputSinkTest : public cybercafe_monitoring_system_test::TempDirTest {
+ protected:
+  std::string ReadFile(const std::filesystem::path& file_path) const {
+    std::ifstream in(file_path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+  }
+};
+
+TEST_F(OutputSinkTest, StreamSinkWritesOnlyAtBufferBoundaries) {
+  std::ostringstream stream;
+  {
+    cybercafe_monitoring_system::StreamOutputSink output(stream, 8);
+
+    output.Write("abc");
+    EXPECT_TRUE(stream.str().empty());
+
+    output.Print("{} {}", 12, "xyz");
+    EXPECT_EQ(stream.str(), "abc12 xyz");
+
+    output.Put('!');
+    EXPECT_EQ(stream.str(), "abc12 xyz");
+  }
+  EXPECT_EQ(stream.str(), "abc12 xyz!");
+}
+
+TEST_F(OutputSinkTest, MemorySinkCollectsEverything) {
+  cybercafe_monitoring_system::MemoryOutputSink output(4);
+  for (int i = 0; i != 100; ++i) output.Print("{}\n", i);
+
+  std::string expected;
+  for (int i = 0; i != 100; ++i) expected += std::to_string(i) + "\n";
+
+  EXPECT_EQ(output.View(), expected);
+
+  output.Clear();
+  EXPECT_TRUE(output.View().empty());
+}
+
+TEST_F(OutputSinkTest, FileSinksWriteWholeOutput) {
+  std::string expected;
+  for (int i = 0; i != 100000; ++i) expected += std::to_string(i) + " line\n";
+
+  {
+    cybercafe_monitoring_system::FileOutputSink file_output(temp_dir / "f.txt");
+    cybercafe_monitoring_system::MappedFileOutputSink mapped_output(
+        temp_dir / "m.txt");
+
+    file_output.Write(expected);
+    for (int i = 0; i != 100000; ++i) mapped_output.Print("{} line\n", i);
+  }
+
+  EXPECT_EQ(ReadFile(temp_dir / "f.txt"), expected);
+  EXPECT_EQ(ReadFile(temp_dir / "m.txt"), expected);
+}
+
+TEST_F(OutputSinkTest, FileSinkReportsWriteErrorsOnlyWhenAsked) {
+  if (not std::filesystem::exists("/dev/full")) GTEST_SKIP();
+
+  {
+    cybercafe_monitoring_system::FileOutputSink output("/dev/full", 4);
+    EXPECT_THROW(output.Print("{}\n", 12345), std::runtime_error);
+    EXPECT_THROW(output.Close(), std::runtime_error);
+  }
+  {
+    // Destroyed with unwritten text, without terminating
+    cybercafe_monitoring_system::FileOutputSink output("/dev/full");
+    output.Write("lost\n");
+  }
+  {
+    cybercafe_monitoring_system::MappedFileOutputSink output(temp_dir / "m");
+    output.Write("kept\n");
+  }
+  EXPECT_EQ(ReadFile(temp_dir / "m"), "kept\n");
+}
+
+TEST_F(OutputSinkTest, NullSinkAcceptsOutput) {
+  cybercafe_monitoring_system::NullOutputSink output(16);
+  for (int i = 0; i != 1000; ++i) output.Print("{}\n", i);
+  EXPECT_NO_THROW(output.Flush());
+}
+
+TEST_F(OutputSinkTest, SystemWritesThroughGivenSink) {
+  cybercafe_monitoring_system::MemoryOutputSink output;
+  CybercafeMonitoringSystem system(TimePoint{minutes{9 * 60}},
+                                   TimePoint{minutes{19 * 60}}, 2, 10, output);
+
+  system.StartWorkDayTrigger();
+  CybercafeMonitoringSystem::ClientArrivedEvent(TimePoint{minutes{8 * 60 + 48}},
+                                                "client1")
+      .Handle(system);
+  CybercafeMonitoringSystem::ClientArrivedEvent(TimePoint{minutes{9 * 60 + 41}},
+                                                "client1")
+      .Handle(system);
+  CybercafeMonitoringSystem::ClientSatAtTableEvent(
+      TimePoint{minutes{9 * 60 + 54}}, "client1", 2,
+      CybercafeMonitoringSystem::Event::Type::kIncoming)
+      .Handle(system);
+  system.EndWorkDayTrigger();
+
+  EXPECT_EQ(output.View(),
+            "09:00\n"
+            "08:48 1 client1\n"
+            "08:48 13 NotOpenYet\n"
+            "09:41 1 client1\n"
+            "09:54 2 client1 2\n"
+            "19:00 11 client1\n"
+            "19:00\n"
+            "1 0 00:00\n"
+            "2 100 09:06");
+}
+
+}  // namespace
@@ -0,0 +1,191 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Parallel event lines parsing testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/parallel_event_parser.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "include/day_log_generator.h"
+#include "include/event_line_parser.h"
+#include "include/output_sink.h"
+#include "include/read_input_data.h"
+#include "tests/processing_test_helpers.h"
+
+namespace {
+
+using cybercafe_monitoring_system::MemoryOutputSink;
+using cybercafe_monitoring_system::ParallelParseOptions;
+using cybercafe_monitoring_system::ParseEventLinesParallel;
+using cybercafe_monitoring_system_test::RunProcessing;
+
+// README sample input
+constexpr std::string_view kDay =
+    "3\n"
+    "09:00 19:00\n"
+    "10\n"
+    "08:48 1 client1\n"
+    "09:41 1 client1\n"
+    "09:48 1 client2\n"
+    "09:52 3 client1\n"
+    "09:54 2 client1 1\n"
+    "10:25 2 client2 2\n"
+    "10:58 1 client3\n"
+    "10:59 2 client3 3\n"
+    "11:30 1 client4\n"
+    "11:35 2 client4 2\n"
+    "11:45 3 client4\n"
+    "12:33 4 client1\n"
+    "12:43 4 client2\n"
+    "15:52 4 client4\n";
+
+// The event lines of the README sample
+constexpr std::string_view kEvents = kDay.substr(kDay.find("08:48"));
+
+class ParallelEventParserTest
+    : public cybercafe_monitoring_system_test::TempDirTest {
+ protected:
+  // The parallel and the buffered processing of the file agree
+  static void ExpectSameAsBuffered(const std::filesystem::path& file_path) {
+    const auto buffered = RunProcessing([&](MemoryOutputSink& output) {
+      std::ifstream file(file_path);
+      cybercafe_monitoring_system_test::ProcessingInputData(file, output);
+    });
+    for (size_t threads_count : {1, 4}) {
+      const auto parallel = RunProcessing([&](MemoryOutputSink& output) {
+        cybercafe_monitoring_system_test::ProcessingParallelInputData(
+            file_path, output, threads_count);
+      });
+      EXPECT_EQ(parallel, buffered) << threads_count;
+    }
+  }
+};
+
+TEST_F(ParallelEventParserTest, AnyChunkSizeGivesTheLinesInOrder) {
+  std::string_view text = kEvents;
+  std::vector<cybercafe_monitoring_system::ParsedEventLine> expected;
+  while (not text.empty())
+    expected.push_back(cybercafe_monitoring_system::ParseEventLine(
+        cybercafe_monitoring_system::NextLine(text)));
+
+  for (size_t chunk_size : {0, 1, 7, 16, 40, 1000}) {
+    const auto result = ParseEventLinesParallel(kEvents, {3, chunk_size});
+    EXPECT_FALSE(result.incorrect_line) << chunk_size;
+    EXPECT_EQ(result.order_violation, expected.size()) << chunk_size;
+
+    ASSERT_EQ(result.events.size(), expected.size()) << chunk_size;
+    for (size_t i = 0; i != expected.size(); ++i) {
+      EXPECT_EQ(result.events[i].time, expected[i].time);
+      EXPECT_EQ(result.events[i].id, expected[i].id);
+      EXPECT_EQ(result.events[i].client_name, expected[i].client_name);
+      EXPECT_EQ(result.events[i].table_id, expected[i].table_id);
+    }
+  }
+}
+
+TEST_F(ParallelEventParserTest, FindsTheFirstIncorrectLine) {
+  const std::string text =
+      "09:10 1 client1\n09:20 1 Client2\n09:30 1 client3\n09:40 9 client4\n"
+      "09:50 1 client5";
+
+  for (size_t chunk_size : {1, 16, 17, 40, 1000}) {
+    const ParallelParseOptions options{4, chunk_size};
+    const auto result = ParseEventLinesParallel(text, options);
+    ASSERT_TRUE(result.incorrect_line) << chunk_size;
+    EXPECT_EQ(*result.incorrect_line, "09:20 1 Client2") << chunk_size;
+    EXPECT_EQ(result.events.size(), 1u) << chunk_size;
+  }
+}
+
+TEST_F(ParallelEventParserTest, FindsTheFirstOrderViolation) {
+  // Inside a chunk and on the border of two
+  const std::string text =
+      "09:10 1 client1\n09:20 1 client2\n09:15 1 client3\n09:05 1 client4\n";
+
+  for (size_t chunk_size : {1, 16, 17, 33, 1000}) {
+    const auto result = ParseEventLinesParallel(text, {2, chunk_size});
+    EXPECT_FALSE(result.incorrect_line) << chunk_size;
+    EXPECT_EQ(result.order_violation, 2u) << chunk_size;
+  }
+}
+
+TEST_F(ParallelEventParserTest, GetsTheLineAroundACharacter) {
+  constexpr std::string_view text = "09:10 1 client1\n09:20 1 client2";
+
+  EXPECT_EQ(cybercafe_monitoring_system::GetLineAround(text, text.data() + 8),
+            "09:10 1 client1");
+  EXPECT_EQ(cybercafe_monitoring_system::GetLineAround(text, text.data() + 24),
+            "09:20 1 client2");
+}
+
+TEST_F(ParallelEventParserTest, MatchesBufferedProcessing) {
+  ExpectSameAsBuffered(CreateFile("readme.txt", kDay));
+
+  // Several chunks with errors, waiting clients and clients left at closing
+  cybercafe_monitoring_system::DayLogOptions options;
+  options.events_count = 100000;
+  options.error_ratio = 0.05;
+  {
+    cybercafe_monitoring_system::FileOutputSink log(temp_dir / "day.txt");
+    cybercafe_monitoring_system::GenerateDayLog(options, log);
+  }
+  ExpectSameAsBuffered(temp_dir / "day.txt");
+
+  const std::string header(kDay.substr(0, kDay.find("08:48")));
+  for (std::string_view events :
+       {"09:10 1 client1\n09:20 1 Client2\n09:30 1 client3\n",
+        "09:10 1 client1\n09:2 1 client2\n",
+        "09:10 1 client1\n09:05 1 client2\n09:20 1 client3\n",
+        "09:10 1 client1\n09:05 1 client2\n09:20 1 Client3\n",
+        "09:10 1 client1\n09:20 1 client2\n09:15 1 client3\n"
+        "09:30 1 client4\n"}) {
+    ExpectSameAsBuffered(CreateFile("bad.txt", header + std::string(events)));
+  }
+
+  // An event earlier than the one before it in the middle of the day is
+  // printed alone, before anything is handled
+  const auto [unordered_output, unordered_error] =
+      RunProcessing([&](MemoryOutputSink& output) {
+        cybercafe_monitoring_system_test::ProcessingParallelInputData(
+            CreateFile("bad.txt", header +
+                                      "09:10 1 client1\n09:20 1 client2\n"
+                                      "09:15 1 client3\n09:30 1 client4\n"),
+            output, 4);
+      });
+  EXPECT_EQ(unordered_output, "09:15 1 client3\n");
+  EXPECT_EQ(unordered_error, "order");
+
+  // An unknown id is reported by its line too, as the mapped processing does
+  const auto [output, error] = RunProcessing([&](MemoryOutputSink& output) {
+    cybercafe_monitoring_system_test::ProcessingParallelInputData(
+        CreateFile("bad.txt", header + "09:10 1 client1\n09:20 9 client2\n"),
+        output);
+  });
+  EXPECT_EQ(output, "");
+  EXPECT_EQ(error, "09:20 9 client2");
+
+  // An event rejected while handling it is reported after the earlier output
+  const auto [rejected_output, rejected_error] =
+      RunProcessing([&](MemoryOutputSink& output) {
+        cybercafe_monitoring_system_test::ProcessingParallelInputData(
+            CreateFile("bad.txt", header + "09:10 1 client1\n"
+                                           "09:20 2 client1 7\n"),
+            output);
+      });
+  EXPECT_EQ(rejected_output, "09:00\n09:10 1 client1\n09:20 2 client1 7\n");
+  EXPECT_EQ(rejected_error, "09:20 2 client1 7");
+}
+
+}  // namespace
@@ -0,0 +1,74 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Temporary files and processing runs shared by the tests
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#ifndef TESTS_PROCESSING_TEST_HELPERS_H_
+#define TESTS_PROCESSING_TEST_HELPERS_H_
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "include/output_sink.h"
+#include "include/read_input_data.h"
+
+namespace cybercafe_monitoring_system_test {
+
+// Gives every test its own temporary directory, named after the test, so the
+// tests can run in parallel processes
+class TempDirTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const ::testing::TestInfo* test_info =
+        ::testing::UnitTest::GetInstance()->current_test_info();
+    std::string name = std::string("cybercafe_") +
+                       test_info->test_suite_name() + "_" + test_info->name();
+    std::ranges::replace(name, '/', '_');
+
+    temp_dir = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(temp_dir);
+    std::filesystem::create_directory(temp_dir);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(temp_dir); }
+
+  std::filesystem::path CreateFile(const std::filesystem::path& name,
+                                   std::string_view content) const {
+    std::ofstream(temp_dir / name, std::ios::binary) << content;
+    return temp_dir / name;
+  }
+
+  std::filesystem::path temp_dir;
+};
+
+// Output and error of a run, "" if there is no error and "order" if the
+// events are not in chronological order
+template <typename Processing>
+std::pair<std::string, std::string> RunProcessing(Processing&& processing) {
+  cybercafe_monitoring_system::MemoryOutputSink output;
+  std::string error;
+  try {
+    processing(output);
+  } catch (const EventsOrderViolation&) {
+    error = "order";
+  } catch (const std::runtime_error& e) {
+    error = e.what();
+  }
+  return {std::string(output.View()), error};
+}
+
+}  // namespace cybercafe_monitoring_system_test
+
+#endif  // TESTS_PROCESSING_TEST_HELPERS_H_
@@ -0,0 +1,123 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// State at time queries testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/replay_engine.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "include/output_sink.h"
+
+namespace {
+
+using cybercafe_monitoring_system::EventLogHeader;
+using cybercafe_monitoring_system::MemoryOutputSink;
+using cybercafe_monitoring_system::NullOutputSink;
+using cybercafe_monitoring_system::ReplayEngine;
+
+// README sample day
+constexpr EventLogHeader kHeader{9 * 60, 19 * 60, 3, 10};
+
+constexpr std::string_view kEvents =
+    "08:48 1 client1\n"
+    "09:41 1 client1\n"
+    "09:48 1 client2\n"
+    "09:52 3 client1\n"
+    "09:54 2 client1 1\n"
+    "10:25 2 client2 2\n"
+    "10:58 1 client3\n"
+    "10:59 2 client3 3\n"
+    "11:30 1 client4\n"
+    "11:35 2 client4 2\n"
+    "11:45 3 client4\n"
+    "12:33 4 client1\n"
+    "12:43 4 client2\n"
+    "15:52 4 client4\n";
+
+std::string StateAt(const ReplayEngine& engine, int32_t minutes) {
+  MemoryOutputSink output;
+  engine.PrintStateAt(minutes, output);
+  return std::string(output.View());
+}
+
+TEST(ReplayEngineTest, PrintsStateAtTime) {
+  const ReplayEngine engine(kHeader, kEvents, 4);
+
+  EXPECT_EQ(StateAt(engine, 9 * 60), "09:00\nwaiting:\n");
+  EXPECT_EQ(StateAt(engine, 11 * 60 + 40),
+            "11:40\n1 client1\n2 client2\n3 client3\nwaiting:\n");
+  EXPECT_EQ(StateAt(engine, 11 * 60 + 45),
+            "11:45\n1 client1\n2 client2\n3 client3\nwaiting: client4\n");
+  EXPECT_EQ(StateAt(engine, 12 * 60 + 33),
+            "12:33\n1 client4\n2 client2\n3 client3\nwaiting:\n");
+  EXPECT_EQ(StateAt(engine, 16 * 60), "16:00\n3 client3\nwaiting:\n");
+  EXPECT_EQ(StateAt(engine, 18 * 60 + 59), "18:59\n3 client3\nwaiting:\n");
+}
+
+TEST(ReplayEngineTest, DayIsClosedFromTheClosingTime) {
+  const ReplayEngine engine(kHeader, kEvents, 4);
+
+  EXPECT_EQ(StateAt(engine, 19 * 60), "19:00\nwaiting:\n");
+  EXPECT_EQ(StateAt(engine, 23 * 60 + 59), "23:59\nwaiting:\n");
+
+  // client3 left at the closing, as in the processing of the whole day
+  MemoryOutputSink output;
+  auto system = engine.MakeSystem(output);
+  engine.RestoreAt(19 * 60, system);
+  EXPECT_EQ(system.GetTotalRevenue(), 30 + 30 + 90 + 40);
+  EXPECT_NE(output.View().find("19:00 11 client3\n"), std::string_view::npos);
+}
+
+TEST(ReplayEngineTest, AnyIntervalGivesTheSameStates) {
+  const ReplayEngine full_replay(kHeader, kEvents, 1000);
+  EXPECT_EQ(full_replay.GetCheckpointsCount(), 1u);
+
+  for (uint64_t interval_events : {1, 2, 3, 5}) {
+    const ReplayEngine engine(kHeader, kEvents, interval_events);
+    EXPECT_EQ(engine.GetCheckpointsCount(), 1 + 14 / interval_events);
+
+    for (int32_t minutes = 8 * 60; minutes != 20 * 60; ++minutes) {
+      ASSERT_EQ(StateAt(engine, minutes), StateAt(full_replay, minutes))
+          << "interval " << interval_events << ", minute " << minutes;
+
+      // Only the events after the nearest checkpoint are handled
+      NullOutputSink output;
+      auto system = engine.MakeSystem(output);
+      EXPECT_LE(engine.RestoreAt(minutes, system), interval_events);
+    }
+  }
+}
+
+TEST(ReplayEngineTest, RestoredSystemHasRevenue) {
+  const ReplayEngine engine(kHeader, kEvents, 2);
+  NullOutputSink output;
+  auto system = engine.MakeSystem(output);
+
+  // client1 paid for 09:54 - 12:33, client2 for 10:25 - 12:43
+  engine.RestoreAt(13 * 60, system);
+  EXPECT_EQ(system.GetTotalRevenue(), 30 + 30);
+}
+
+TEST(ReplayEngineTest, ReportsIncorrectLine) {
+  try {
+    ReplayEngine engine(kHeader, "09:10 1 client1\n09:05 1 client2\n");
+    FAIL() << "Expected std::runtime_error";
+  } catch (const std::runtime_error& e) {
+    EXPECT_STREQ(e.what(), "09:05 1 client2");
+  }
+
+  EXPECT_THROW(ReplayEngine(kHeader, "09:10 7 client1\n"),
+               std::runtime_error);
+}
+
+}  // namespace
@@ -0,0 +1,212 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Session ledger and re-pricing testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include "include/session_ledger.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "include/cybercafe_monitoring_system.h"
+#include "include/event_line_parser.h"
+#include "include/output_sink.h"
+
+namespace {
+
+using cybercafe_monitoring_system::ClientId;
+using cybercafe_monitoring_system::CybercafeMonitoringSystem;
+using cybercafe_monitoring_system::NullOutputSink;
+using cybercafe_monitoring_system::RepriceSessions;
+using cybercafe_monitoring_system::RevenueReport;
+using cybercafe_monitoring_system::SessionLedger;
+using cybercafe_monitoring_system::TariffPlan;
+using cybercafe_monitoring_system::TimePoint;
+
+// README sample day
+constexpr std::string_view kEvents[] = {
+    "08:48 1 client1",   "09:41 1 client1",   "09:48 1 client2",
+    "09:52 3 client1",   "09:54 2 client1 1", "10:25 2 client2 2",
+    "10:58 1 client3",   "10:59 2 client3 3", "11:30 1 client4",
+    "11:35 2 client4 2", "11:45 3 client4",   "12:33 4 client1",
+    "12:43 4 client2",   "15:52 4 client4",
+};
+
+int32_t Minutes(int hours, int minutes) { return hours * 60 + minutes; }
+
+class SessionLedgerTest : public ::testing::Test {
+ protected:
+  SessionLedgerTest()
+      : system_(TimePoint{std::chrono::minutes{Minutes(9, 0)}},
+                TimePoint{std::chrono::minutes{Minutes(19, 0)}}, 3, 10,
+                output_) {
+    system_.StartWorkDayTrigger();
+    for (std::string_view line : kEvents) {
+      auto parsed = cybercafe_monitoring_system::ParseEventLine(line);
+      system_.Handle(system_.MakeEventRecord(
+          parsed.time, parsed.id, parsed.client_name, parsed.table_id));
+    }
+    system_.EndWorkDayTrigger();
+  }
+
+  // Reports of the day under the plans
+  std::vector<RevenueReport> Reprice(std::vector<TariffPlan> plans) {
+    std::vector<RevenueReport> reports(plans.size(), RevenueReport(3));
+    RepriceSessions(system_.GetSessionLedger(), plans, reports);
+    return reports;
+  }
+
+  NullOutputSink output_;
+
+  CybercafeMonitoringSystem system_;
+};
+
+TEST_F(SessionLedgerTest, RecordsEverySession) {
+  const SessionLedger& ledger = system_.GetSessionLedger();
+  ASSERT_EQ(ledger.Size(), 4u);
+
+  std::vector<std::string> clients;
+  for (size_t session = 0; session != ledger.Size(); ++session)
+    clients.emplace_back(ledger.GetClientName(session));
+
+  // client3 is still inside at the closing time
+  EXPECT_EQ(clients, (std::vector<std::string>{"client1", "client2",
+                                                "client4", "client3"}));
+  EXPECT_EQ(std::vector(ledger.GetTables().begin(), ledger.GetTables().end()),
+            (std::vector<int32_t>{1, 2, 1, 3}));
+  EXPECT_EQ(std::vector(ledger.GetStarts().begin(), ledger.GetStarts().end()),
+            (std::vector<int32_t>{Minutes(9, 54), Minutes(10, 25),
+                                  Minutes(12, 33), Minutes(10, 59)}));
+  EXPECT_EQ(std::vector(ledger.GetEnds().begin(), ledger.GetEnds().end()),
+            (std::vector<int32_t>{Minutes(12, 33), Minutes(12, 43),
+                                  Minutes(15, 52), Minutes(19, 0)}));
+  EXPECT_EQ(
+      std::vector(ledger.GetCharges().begin(), ledger.GetCharges().end()),
+      (std::vector<int64_t>{30, 30, 40, 90}));
+
+  // The next day starts with an empty ledger
+  system_.StartWorkDayTrigger();
+  EXPECT_EQ(system_.GetSessionLedger().Size(), 0u);
+}
+
+TEST_F(SessionLedgerTest, HourlyPlanMatchesTheSystem) {
+  const RevenueReport report = Reprice({{10, 60, 0}})[0];
+
+  for (int table_id = 1; table_id <= 3; ++table_id)
+    EXPECT_EQ(report.tables[static_cast<size_t>(table_id - 1)],
+              system_.GetTablesStats().GetRevenue(table_id));
+  EXPECT_EQ(report.total, system_.GetTotalRevenue());
+
+  std::array<int64_t, 24> hours{};
+  hours[9] = 30;
+  hours[10] = 30 + 90;
+  hours[12] = 40;
+  EXPECT_EQ(report.hours, hours);
+}
+
+TEST_F(SessionLedgerTest, PerMinuteBillingAndCaps) {
+  const auto reports = Reprice({{1, 1, 0}, {10, 60, 35}, {25, 120, 0}});
+
+  // 159, 138, 199 and 481 minutes
+  EXPECT_EQ(reports[0].total, 159 + 138 + 199 + 481);
+  EXPECT_EQ(reports[0].tables, (std::vector<int64_t>{159 + 199, 138, 481}));
+
+  EXPECT_EQ(reports[1].total, 30 + 30 + 35 + 35);
+  EXPECT_EQ(reports[1].tables, (std::vector<int64_t>{30 + 35, 30, 35}));
+
+  EXPECT_EQ(reports[2].total, 50 + 50 + 50 + 125);
+}
+
+TEST_F(SessionLedgerTest, ReportsOfManyDaysAddUp) {
+  const std::vector<TariffPlan> plans = {{10, 60, 0}};
+  std::vector<RevenueReport> reports(1, RevenueReport(3));
+  RepriceSessions(system_.GetSessionLedger(), plans, reports);
+  RepriceSessions(system_.GetSessionLedger(), plans, reports);
+
+  EXPECT_EQ(reports[0].total, 2 * system_.GetTotalRevenue());
+  EXPECT_EQ(reports[0].tables, (std::vector<int64_t>{140, 60, 180}));
+}
+
+TEST(RepriceSessionsTest, MatchesDirectPricing) {
+  std::mt19937 random(22);
+  std::uniform_int_distribution<int32_t> table(1, 50);
+  std::uniform_int_distribution<int32_t> minute(0, 24 * 60 - 1);
+
+  // Several blocks and a partial one
+  SessionLedger ledger;
+  for (int i = 0; i != 5000; ++i) {
+    const int32_t start = minute(random);
+    const int32_t end = std::min(start + minute(random) / 2, 24 * 60);
+    ledger.Append(static_cast<ClientId>(i % 700),
+                  "client" + std::to_string(i % 700), table(random), start,
+                  end, 0);
+  }
+
+  const std::vector<TariffPlan> plans = {
+      {10, 60, 0}, {1, 1, 0}, {7, 15, 50}, {0, 30, 0}, {100, 1440, 99}};
+  std::vector<RevenueReport> reports(plans.size(), RevenueReport(50));
+  RepriceSessions(ledger, plans, reports);
+
+  for (size_t plan = 0; plan != plans.size(); ++plan) {
+    RevenueReport expected(50);
+    for (size_t i = 0; i != ledger.Size(); ++i) {
+      const int64_t duration = ledger.GetEnds()[i] - ledger.GetStarts()[i];
+      int64_t charge =
+          (duration + plans[plan].billing_minutes - 1) /
+          plans[plan].billing_minutes * plans[plan].rate;
+      if (plans[plan].session_cap != 0)
+        charge = std::min(charge, plans[plan].session_cap);
+
+      expected.tables[static_cast<size_t>(ledger.GetTables()[i] - 1)] +=
+          charge;
+      expected.hours[static_cast<size_t>(ledger.GetStarts()[i] / 60)] +=
+          charge;
+      expected.total += charge;
+    }
+
+    EXPECT_EQ(reports[plan].tables, expected.tables) << "plan " << plan;
+    EXPECT_EQ(reports[plan].hours, expected.hours) << "plan " << plan;
+    EXPECT_EQ(reports[plan].total, expected.total) << "plan " << plan;
+  }
+}
+
+TEST(RepriceSessionsTest, RejectsIncorrectInput) {
+  SessionLedger ledger;
+  ledger.Append(0, "client1", 2, 600, 660, 10);
+
+  std::vector<RevenueReport> reports(1, RevenueReport(2));
+  const std::vector<TariffPlan> plans = {{10, 60, 0}, {10, 60, 0}};
+  EXPECT_THROW(RepriceSessions(ledger, plans, reports),
+               std::invalid_argument);
+
+  for (TariffPlan plan : {TariffPlan{-1, 60, 0}, TariffPlan{10, 0, 0},
+                          TariffPlan{10, 60, -5}})
+    EXPECT_THROW(RepriceSessions(ledger, {&plan, 1}, reports),
+                 std::invalid_argument);
+
+  // Table 2 does not fit a report of one table
+  std::vector<RevenueReport> small_reports(1, RevenueReport(1));
+  EXPECT_THROW(RepriceSessions(ledger, {plans.data(), 1}, small_reports),
+               std::invalid_argument);
+
+  SessionLedger backwards;
+  backwards.Append(0, "client1", 1, 660, 600, 0);
+  EXPECT_THROW(RepriceSessions(backwards, {plans.data(), 1}, reports),
+               std::invalid_argument);
+}
+
+}  // namespace
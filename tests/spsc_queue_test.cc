@@ -0,0 +1,38 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Single producer single consumer queue testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+#include "include/spsc_queue.h"
+
+namespace {
+
+using cybercafe_monitoring_system::SpscQueue;
+
+TEST(SpscQueueTest, CapacityIsPowerOfTwo) {
+  EXPECT_EQ(SpscQueue<int>(5).Capacity(), 8u);
+  EXPECT_EQ(SpscQueue<int>(0).Capacity(), 2u);
+}
+
+TEST(SpscQueueTest, KeepsOrderAcrossThreads) {
+  constexpr int kCount = 100000;
+  SpscQueue<std::string> queue(16);
+
+  std::jthread producer([&queue] {
+    for (int i = 0; i != kCount; ++i) queue.Push(std::to_string(i));
+  });
+
+  for (int i = 0; i != kCount; ++i) ASSERT_EQ(queue.Pop(), std::to_string(i));
+}
+
+}  // namespace
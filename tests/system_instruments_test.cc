@@ -0,0 +1,145 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Hot path instrumentation testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include "include/cybercafe_monitoring_system.h"
+#include "include/event_line_parser.h"
+#include "include/output_sink.h"
+#include "include/system_instruments.h"
+
+namespace {
+
+using cybercafe_monitoring_system::CybercafeMonitoringSystem;
+using cybercafe_monitoring_system::ErrorReason;
+using cybercafe_monitoring_system::InstrumentedHandler;
+using cybercafe_monitoring_system::InstrumentsSnapshot;
+using cybercafe_monitoring_system::MemoryOutputSink;
+using cybercafe_monitoring_system::TimePoint;
+
+// README sample day
+constexpr std::string_view kDay[] = {
+    "08:48 1 client1",   "09:41 1 client1",   "09:48 1 client2",
+    "09:52 3 client1",   "09:54 2 client1 1", "10:25 2 client2 2",
+    "10:58 1 client3",   "10:59 2 client3 3", "11:30 1 client4",
+    "11:35 2 client4 2", "11:45 3 client4",   "12:33 4 client1",
+    "12:43 4 client2",   "15:52 4 client4",
+};
+
+size_t Index(ErrorReason reason) { return static_cast<size_t>(reason); }
+
+size_t Index(InstrumentedHandler handler) {
+  return static_cast<size_t>(handler);
+}
+
+class SystemInstrumentsTest : public ::testing::Test {
+ protected:
+  void RunDay() {
+    system.SetInstrumentsReport(&report);
+    system.StartWorkDayTrigger();
+    for (std::string_view line : kDay) {
+      auto parsed = cybercafe_monitoring_system::ParseEventLine(line);
+      system.Handle(system.MakeEventRecord(parsed.time, parsed.id,
+                                           parsed.client_name,
+                                           parsed.table_id));
+    }
+    system.EndWorkDayTrigger();
+  }
+
+  MemoryOutputSink output, report;
+
+  CybercafeMonitoringSystem system{TimePoint{std::chrono::minutes{9 * 60}},
+                                   TimePoint{std::chrono::minutes{19 * 60}},
+                                   3, 10, output};
+};
+
+TEST_F(SystemInstrumentsTest, ErrorTextsMatchOutput) {
+  EXPECT_EQ(GetErrorReasonText(ErrorReason::kYouShallNotPass),
+            "YouShallNotPass");
+  EXPECT_EQ(GetErrorReasonText(ErrorReason::kICanWaitNoLonger),
+            "ICanWaitNoLonger!");
+  EXPECT_EQ(GetErrorReasonText(ErrorReason::kYouAlreadyAtTable),
+            "YouAlreadyAtTable!");
+}
+
+TEST_F(SystemInstrumentsTest, SnapshotCountsTheDay) {
+  RunDay();
+  InstrumentsSnapshot snapshot = system.GetInstrumentsSnapshot();
+
+  if (not cybercafe_monitoring_system::kInstrumentationEnabled) {
+    EXPECT_EQ(snapshot.events[1], 0u);
+    EXPECT_EQ(report.View(), "");
+    return;
+  }
+
+  EXPECT_EQ(snapshot.events[1], 5u);
+  EXPECT_EQ(snapshot.events[2], 4u);
+  EXPECT_EQ(snapshot.events[3], 2u);
+  EXPECT_EQ(snapshot.events[4], 3u);
+  EXPECT_EQ(snapshot.events[11], 1u);
+  EXPECT_EQ(snapshot.events[12], 1u);
+  EXPECT_EQ(snapshot.events[13], 3u);
+  EXPECT_EQ(snapshot.errors[Index(ErrorReason::kNotOpenYet)], 1u);
+  EXPECT_EQ(snapshot.errors[Index(ErrorReason::kICanWaitNoLonger)], 1u);
+  EXPECT_EQ(snapshot.errors[Index(ErrorReason::kPlaceIsBusy)], 1u);
+  EXPECT_EQ(snapshot.max_waiting_clients, 1u);
+  EXPECT_EQ(snapshot.max_occupied_tables, 3);
+  EXPECT_EQ(
+      snapshot.handlers_latency[Index(InstrumentedHandler::kClientArrived)]
+          .GetCount(),
+      5u);
+  EXPECT_EQ(
+      snapshot.handlers_latency[Index(InstrumentedHandler::kClientDeparture)]
+          .GetCount(),
+      4u);
+
+  std::string_view dump = report.View();
+  EXPECT_TRUE(dump.starts_with("events 1:5 2:4 3:2 4:3 11:1 12:1 13:3\n"));
+  EXPECT_NE(dump.find("max waiting clients 1 max occupied tables 3\n"),
+            std::string_view::npos);
+}
+
+TEST_F(SystemInstrumentsTest, CountersStartOverEveryDay) {
+  RunDay();
+  output.Clear();
+  RunDay();
+
+  const auto expected_arrivals =
+      cybercafe_monitoring_system::kInstrumentationEnabled ? 5u : 0u;
+  EXPECT_EQ(system.GetInstrumentsSnapshot().events[1], expected_arrivals);
+}
+
+TEST(PrintInstrumentsSnapshotTest, PrintsEveryCounter) {
+  InstrumentsSnapshot snapshot;
+  snapshot.events[13] = 2;
+  snapshot.errors[Index(ErrorReason::kClientUnknown)] = 2;
+  snapshot.handlers_latency[Index(InstrumentedHandler::kClientLeft)].Record(
+      std::chrono::nanoseconds{5});
+
+  MemoryOutputSink output;
+  PrintInstrumentsSnapshot(snapshot, output);
+
+  EXPECT_EQ(output.View(),
+            "events 1:0 2:0 3:0 4:0 11:0 12:0 13:2\n"
+            "errors YouShallNotPass:0 NotOpenYet:0 PlaceIsBusy:0 "
+            "ClientUnknown:2 ICanWaitNoLonger!:0 YouAlreadyAtTable!:0\n"
+            "max waiting clients 0 max occupied tables 0\n"
+            "ClientArrived count 0 p50 0ns p99 0ns max 0ns\n"
+            "ClientSatAtTable count 0 p50 0ns p99 0ns max 0ns\n"
+            "ClientWaiting count 0 p50 0ns p99 0ns max 0ns\n"
+            "ClientLeft count 1 p50 5ns p99 5ns max 5ns\n"
+            "ClientDeparture count 0 p50 0ns p99 0ns max 0ns\n");
+}
+
+}  // namespace
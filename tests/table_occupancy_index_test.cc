@@ -0,0 +1,89 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Table occupancy index testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+#include "include/table_occupancy_index.h"
+
+namespace {
+
+using cybercafe_monitoring_system::ClientId;
+using cybercafe_monitoring_system::kNoClient;
+using cybercafe_monitoring_system::TableOccupancyIndex;
+
+TEST(TableOccupancyIndexTest, OccupyAndRelease) {
+  TableOccupancyIndex index(3);
+
+  EXPECT_FALSE(index.IsOccupied(2));
+  index.Occupy(2, 7);
+  EXPECT_TRUE(index.IsOccupied(2));
+  EXPECT_EQ(index.GetOccupant(2), 7u);
+  EXPECT_EQ(index.GetOccupiedCount(), 1);
+
+  index.Release(2);
+  EXPECT_FALSE(index.IsOccupied(2));
+  EXPECT_EQ(index.GetOccupant(2), cybercafe_monitoring_system::kNoClient);
+  EXPECT_EQ(index.GetOccupiedCount(), 0);
+}
+
+TEST(TableOccupancyIndexTest, FindFirstFreeTableAcrossWords) {
+  TableOccupancyIndex index(130);
+
+  EXPECT_EQ(index.FindFirstFreeTable(), 1);
+
+  for (int table_id = 1; table_id <= 100; ++table_id)
+    index.Occupy(table_id, 0);
+  EXPECT_EQ(index.FindFirstFreeTable(), 101);
+
+  index.Release(64);
+  EXPECT_EQ(index.FindFirstFreeTable(), 64);
+  index.Occupy(64, 0);
+
+  for (int table_id = 101; table_id <= 130; ++table_id)
+    index.Occupy(table_id, 0);
+  EXPECT_EQ(index.FindFirstFreeTable(), 0);
+  EXPECT_EQ(index.GetOccupiedCount(), 130);
+}
+
+TEST(TableOccupancyIndexTest, FullLastWordHasNoFreeTable) {
+  TableOccupancyIndex index(64);
+  for (int table_id = 1; table_id <= 64; ++table_id)
+    index.Occupy(table_id, 0);
+  EXPECT_EQ(index.FindFirstFreeTable(), 0);
+
+  TableOccupancyIndex small_index(2);
+  small_index.Occupy(1, 1);
+  small_index.Occupy(2, 2);
+  EXPECT_EQ(small_index.FindFirstFreeTable(), 0);
+}
+
+TEST(TableOccupancyIndexTest, VisitsOccupiedTablesInOrder) {
+  TableOccupancyIndex index(130);
+  index.Occupy(129, 7);
+  index.Occupy(3, 5);
+  index.Occupy(64, 6);
+
+  std::vector<std::pair<int, ClientId>> visited;
+  index.ForEachOccupied([&visited](int table_id, ClientId client) {
+    visited.emplace_back(table_id, client);
+  });
+  EXPECT_EQ(visited, (std::vector<std::pair<int, ClientId>>{
+                         {3, 5}, {64, 6}, {129, 7}}));
+
+  index.ReleaseAll();
+  EXPECT_EQ(index.GetOccupiedCount(), 0);
+  EXPECT_EQ(index.FindFirstFreeTable(), 1);
+  EXPECT_EQ(index.GetOccupant(64), kNoClient);
+}
+
+}  // namespace
@@ -0,0 +1,49 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Table statistics store testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include "include/table_stats_store.h"
+
+namespace {
+
+using cybercafe_monitoring_system::TableStatsStore;
+
+TEST(TableStatsStoreTest, SessionsAreChargedPerStartedHour) {
+  TableStatsStore stats(3);
+
+  stats.StartSession(2, 10 * 60);
+  EXPECT_EQ(stats.EndSession(2, 11 * 60 + 1, 10), 20);
+
+  stats.StartSession(2, 12 * 60);
+  EXPECT_EQ(stats.EndSession(2, 13 * 60, 10), 10);
+
+  EXPECT_EQ(stats.GetUsedMinutes(2), 121);
+  EXPECT_EQ(stats.GetRevenue(2), 30);
+  EXPECT_EQ(stats.GetRevenue(1), 0);
+  EXPECT_EQ(stats.GetTotalRevenue(), 30);
+}
+
+TEST(TableStatsStoreTest, ResetZeroesEveryTable) {
+  TableStatsStore stats(1000);
+
+  for (int table_id = 1; table_id <= 1000; ++table_id) {
+    stats.StartSession(table_id, 0);
+    stats.EndSession(table_id, 30, 5);
+  }
+  EXPECT_EQ(stats.GetTotalRevenue(), 5000);
+
+  stats.Reset();
+  EXPECT_EQ(stats.GetTotalRevenue(), 0);
+  EXPECT_EQ(stats.GetUsedMinutes(1000), 0);
+  EXPECT_EQ(stats.GetTablesCount(), 1000);
+}
+
+}  // namespace
@@ -0,0 +1,165 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Multi-venue engine testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "include/cybercafe_monitoring_system.h"
+#include "include/output_sink.h"
+#include "include/venue_engine.h"
+
+namespace {
+
+using cybercafe_monitoring_system::CybercafeMonitoringSystem;
+using cybercafe_monitoring_system::MemoryOutputSink;
+using cybercafe_monitoring_system::TimePoint;
+using cybercafe_monitoring_system::VenueConfig;
+using cybercafe_monitoring_system::VenueEngine;
+using std::chrono::minutes;
+
+using Id = CybercafeMonitoringSystem::Event::Id;
+
+struct DayEvent {
+  int minutes;
+  Id id;
+  std::string client_name;
+  int table_id = 0;
+};
+
+// README sample day: revenue 190, tables used for 977 minutes
+const VenueConfig kConfig{TimePoint{minutes{9 * 60}},
+                          TimePoint{minutes{19 * 60}}, 3, 10};
+
+const std::vector<DayEvent> kDay = {
+    {8 * 60 + 48, Id::k1, "client1"},     {9 * 60 + 41, Id::k1, "client1"},
+    {9 * 60 + 48, Id::k1, "client2"},     {9 * 60 + 52, Id::k3, "client1"},
+    {9 * 60 + 54, Id::k2, "client1", 1},  {10 * 60 + 25, Id::k2, "client2", 2},
+    {10 * 60 + 58, Id::k1, "client3"},    {10 * 60 + 59, Id::k2, "client3", 3},
+    {11 * 60 + 30, Id::k1, "client4"},    {11 * 60 + 35, Id::k2, "client4", 2},
+    {11 * 60 + 45, Id::k3, "client4"},    {12 * 60 + 33, Id::k4, "client1"},
+    {12 * 60 + 43, Id::k4, "client2"},    {15 * 60 + 52, Id::k4, "client4"},
+};
+
+// Output of a standalone system for the same day
+std::string ProcessStandalone() {
+  MemoryOutputSink output;
+  CybercafeMonitoringSystem system(kConfig.opening_time, kConfig.closing_time,
+                                   kConfig.tables_count, kConfig.hourly_rate,
+                                   output);
+  system.StartWorkDayTrigger();
+  for (const auto& event : kDay)
+    system.Handle(system.MakeEventRecord(TimePoint{minutes{event.minutes}},
+                                         event.id, event.client_name,
+                                         event.table_id));
+  system.EndWorkDayTrigger();
+  return std::string(output.View());
+}
+
+TEST(VenueEngineTest, VenuesMatchStandaloneSystems) {
+  constexpr int kVenues = 9;
+  std::vector<std::unique_ptr<MemoryOutputSink>> outputs;
+  VenueEngine engine(3);
+
+  for (int venue = 0; venue != kVenues; ++venue) {
+    outputs.push_back(std::make_unique<MemoryOutputSink>());
+    engine.AddVenue(venue, kConfig, *outputs.back());
+  }
+  engine.Start();
+
+  for (int day = 0; day != 2; ++day) {
+    for (int venue = 0; venue != kVenues; ++venue) engine.OpenDay(venue);
+    for (const auto& event : kDay)
+      for (int venue = 0; venue != kVenues; ++venue)
+        engine.Submit(venue, TimePoint{minutes{event.minutes}}, event.id,
+                      event.client_name, event.table_id);
+    for (int venue = 0; venue != kVenues; ++venue) engine.CloseDay(venue);
+  }
+
+  auto chain = engine.GetChainTotals();
+  EXPECT_EQ(chain.venues_count, static_cast<size_t>(kVenues));
+  EXPECT_EQ(chain.revenue, 2 * kVenues * 190);
+  EXPECT_EQ(chain.used_minutes, 2 * kVenues * 977);
+  EXPECT_EQ(chain.handled_events, 2 * kVenues * kDay.size());
+  EXPECT_EQ(chain.rejected_events, 0u);
+
+  const std::string standalone = ProcessStandalone();
+  for (const auto& output : outputs)
+    EXPECT_EQ(output->View(), standalone + standalone);
+}
+
+TEST(VenueEngineTest, RejectsIncorrectEvents) {
+  MemoryOutputSink output;
+  VenueEngine engine(2);
+  engine.AddVenue(7, kConfig, output);
+
+  EXPECT_THROW(engine.OpenDay(7), std::invalid_argument);
+  engine.Start();
+  EXPECT_THROW(engine.AddVenue(8, kConfig, output), std::invalid_argument);
+  EXPECT_THROW(engine.OpenDay(8), std::invalid_argument);
+
+  engine.OpenDay(7);
+  engine.Submit(7, TimePoint{minutes{10 * 60}}, Id::k1, "client1");
+  engine.Submit(7, TimePoint{minutes{10 * 60}}, Id::k1, "Client1");
+  engine.Submit(7, TimePoint{minutes{9 * 60}}, Id::k1, "client2");
+  engine.Submit(7, TimePoint{minutes{10 * 60}}, Id::k11, "client2");
+  engine.Submit(7, TimePoint{minutes{10 * 60}}, Id::k2, "client1", 7);
+  engine.CloseDay(7);
+
+  auto totals = engine.GetVenueTotals(7);
+  EXPECT_EQ(totals.handled_events, 1u);
+  EXPECT_EQ(totals.rejected_events, 4u);
+  EXPECT_FALSE(totals.failed);
+
+  // Rejected events are not printed
+  EXPECT_EQ(output.View().find("client1 7"), std::string::npos);
+}
+
+// Fails every write
+class BrokenOutputSink final
+    : public cybercafe_monitoring_system::OutputSink {
+ public:
+  BrokenOutputSink() : OutputSink(1) {}
+
+ private:
+  void Consume(std::string_view) override {
+    throw std::runtime_error("Cannot write output file");
+  }
+};
+
+TEST(VenueEngineTest, OutputErrorFailsOnlyItsVenue) {
+  BrokenOutputSink broken_output;
+  MemoryOutputSink output;
+  VenueEngine engine(1);
+  engine.AddVenue(1, kConfig, broken_output);
+  engine.AddVenue(2, kConfig, output);
+  engine.Start();
+
+  for (int venue : {1, 2}) {
+    engine.OpenDay(venue);
+    for (const auto& event : kDay)
+      engine.Submit(venue, TimePoint{minutes{event.minutes}}, event.id,
+                    event.client_name, event.table_id);
+    engine.CloseDay(venue);
+  }
+
+  EXPECT_TRUE(engine.GetVenueTotals(1).failed);
+  EXPECT_FALSE(engine.GetVenueTotals(2).failed);
+  EXPECT_EQ(engine.GetVenueTotals(2).revenue, 190);
+  EXPECT_EQ(engine.GetChainTotals().failed_venues_count, 1u);
+  EXPECT_EQ(output.View(), ProcessStandalone());
+}
+
+}  // namespace
@@ -0,0 +1,75 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Waiting queue testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "include/client_name_interner.h"
+#include "include/waiting_queue.h"
+
+namespace {
+
+using cybercafe_monitoring_system::ClientId;
+using cybercafe_monitoring_system::WaitingQueue;
+
+std::vector<ClientId> Contents(const WaitingQueue& queue) {
+  std::vector<ClientId> clients;
+  queue.ForEach([&](ClientId client) { clients.push_back(client); });
+  return clients;
+}
+
+TEST(WaitingQueueTest, KeepsFifoOrder) {
+  WaitingQueue queue;
+  queue.PushBack(5);
+  queue.PushBack(1);
+  queue.PushBack(3);
+
+  EXPECT_EQ(queue.Size(), 3u);
+  EXPECT_EQ(queue.Front(), 5u);
+  queue.PopFront();
+  EXPECT_EQ(queue.Front(), 1u);
+  queue.PopFront();
+  EXPECT_EQ(queue.Front(), 3u);
+  queue.PopFront();
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(WaitingQueueTest, RemovesFromAnyPosition) {
+  WaitingQueue queue;
+  for (ClientId client : {0u, 1u, 2u, 3u, 4u}) queue.PushBack(client);
+
+  queue.Remove(2);
+  queue.Remove(0);
+  queue.Remove(4);
+  queue.Remove(7);
+
+  EXPECT_EQ(Contents(queue), (std::vector<ClientId>{1, 3}));
+  EXPECT_FALSE(queue.Contains(2));
+  EXPECT_TRUE(queue.Contains(3));
+
+  queue.PushBack(0);
+  EXPECT_EQ(Contents(queue), (std::vector<ClientId>{1, 3, 0}));
+}
+
+TEST(WaitingQueueTest, ClientIsQueuedOnce) {
+  WaitingQueue queue;
+  EXPECT_TRUE(queue.PushBack(2));
+  EXPECT_TRUE(queue.PushBack(1));
+  EXPECT_FALSE(queue.PushBack(2));
+
+  EXPECT_EQ(Contents(queue), (std::vector<ClientId>{2, 1}));
+
+  queue.Clear();
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_FALSE(queue.Contains(2));
+}
+
+}  // namespace
@@ -0,0 +1,50 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Work stealing pool testing
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "include/work_stealing_pool.h"
+
+namespace {
+
+using cybercafe_monitoring_system::WorkStealingPool;
+
+TEST(WorkStealingPoolTest, RunsEveryTaskOnce) {
+  WorkStealingPool pool(4);
+  std::vector<std::atomic<int>> runs(1000);
+
+  pool.ForEach(runs.size(), [&](size_t i) { ++runs[i]; });
+
+  for (const auto& run : runs) EXPECT_EQ(run.load(), 1);
+}
+
+TEST(WorkStealingPoolTest, DefaultsToHardwareThreads) {
+  EXPECT_GE(WorkStealingPool().GetThreadsCount(), 1u);
+  WorkStealingPool().ForEach(0, [](size_t) { FAIL(); });
+}
+
+TEST(WorkStealingPoolTest, RethrowsTaskErrorAfterAllTasks) {
+  WorkStealingPool pool(3);
+  std::atomic<int> runs = 0;
+
+  EXPECT_THROW(pool.ForEach(10,
+                            [&](size_t i) {
+                              ++runs;
+                              if (i == 4) throw std::runtime_error("task");
+                            }),
+               std::runtime_error);
+  EXPECT_EQ(runs.load(), 10);
+}
+
+}  // namespace
@@ -0,0 +1,111 @@
+// All Rights Reserved
+//
+// Copyright (c) 2025, github.com/BIBlical33
+//
+// Command line generator of synthetic day logs
+//
+// This software may not be modified without the explicit permission of the
+// copyright holder. For permission requests, please contact:
+// mag1str.kram@gmail.com
+
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "include/day_log_generator.h"
+#include "include/event_line_parser.h"
+#include "include/output_sink.h"
+
+namespace {
+
+constexpr std::string_view kUsage =
+    "Usage: cybercafe_monitoring_system_generator [options]\n"
+    "  --seed <n>               same seed, same log (1)\n"
+    "  --tables <n>             tables count (10)\n"
+    "  --hours <HH:MM> <HH:MM>  opening and closing time (09:00 21:00)\n"
+    "  --rate <n>               hourly rate (10)\n"
+    "  --events <n>             approximate event lines per day (1000)\n"
+    "  --arrivals poisson|rush  arrival distribution (poisson)\n"
+    "  --session <minutes>      mean session length (90)\n"
+    "  --wait-ratio <0..1>      chance to wait when no table is free (0.5)\n"
+    "  --error-ratio <0..1>     share of events answered with k13 (0.02)\n"
+    "  --output <path>          output file, stdout if not given\n"
+    "  --venues <n> --days <n>  write venue<v>_day<d>.txt files into the\n"
+    "                           --output directory\n";
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  using cybercafe_monitoring_system::ArrivalDistribution;
+
+  cybercafe_monitoring_system::DayLogOptions options;
+  std::filesystem::path output_path;
+  int venues_count = 0, days_count = 0;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      const std::string_view option = argv[i];
+      auto value = [&]() -> std::string_view {
+        if (++i >= argc)
+          throw std::invalid_argument(std::string(option) + " needs a value");
+        return argv[i];
+      };
+
+      if (option == "--seed") {
+        options.seed = std::stoull(std::string(value()));
+      } else if (option == "--tables") {
+        options.tables_count = std::stoi(std::string(value()));
+      } else if (option == "--hours") {
+        options.opening_time = cybercafe_monitoring_system::ParseTime(value());
+        options.closing_time = cybercafe_monitoring_system::ParseTime(value());
+      } else if (option == "--rate") {
+        options.hourly_rate = std::stoi(std::string(value()));
+      } else if (option == "--events") {
+        options.events_count = std::stoull(std::string(value()));
+      } else if (option == "--arrivals") {
+        const std::string_view arrivals = value();
+        if (arrivals == "poisson")
+          options.arrivals = ArrivalDistribution::kPoisson;
+        else if (arrivals == "rush")
+          options.arrivals = ArrivalDistribution::kRushHour;
+        else
+          throw std::invalid_argument("Unknown arrivals: " +
+                                      std::string(arrivals));
+      } else if (option == "--session") {
+        options.mean_session_minutes = std::stod(std::string(value()));
+      } else if (option == "--wait-ratio") {
+        options.wait_ratio = std::stod(std::string(value()));
+      } else if (option == "--error-ratio") {
+        options.error_ratio = std::stod(std::string(value()));
+      } else if (option == "--output") {
+        output_path = value();
+      } else if (option == "--venues") {
+        venues_count = std::stoi(std::string(value()));
+      } else if (option == "--days") {
+        days_count = std::stoi(std::string(value()));
+      } else {
+        throw std::invalid_argument("Unknown option: " + std::string(option));
+      }
+    }
+
+    if (venues_count > 0 or days_count > 0) {
+      if (output_path.empty())
+        throw std::invalid_argument("--venues and --days need --output");
+
+      cybercafe_monitoring_system::GenerateVenueDays(
+          options, std::max(venues_count, 1), std::max(days_count, 1),
+          output_path);
+    } else if (output_path.empty()) {
+      cybercafe_monitoring_system::StreamOutputSink output(std::cout);
+      cybercafe_monitoring_system::GenerateDayLog(options, output);
+    } else {
+      cybercafe_monitoring_system::FileOutputSink output(output_path);
+      cybercafe_monitoring_system::GenerateDayLog(options, output);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\n" << kUsage;
+    return 1;
+  }
+}